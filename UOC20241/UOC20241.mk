@@ -37,7 +37,7 @@ ArchiveOutputSwitch    :=
 PreprocessOnlySwitch   :=-E
 ObjectsFileList        :=$(IntermediateDirectory)/ObjectsList.txt
 PCHCompileFlags        :=
-LinkOptions            :=  
+LinkOptions            :=  -pthread
 IncludePath            :=  $(IncludeSwitch). $(IncludeSwitch). $(IncludeSwitch)./test/include $(IncludeSwitch)./UOCTaxation/include 
 IncludePCH             := 
 RcIncludePath          := 
@@ -62,7 +62,7 @@ AS       := /usr/bin/as
 ## User defined environment variables
 ##
 CodeLiteDir:=/usr/share/codelite
-Objects0=$(IntermediateDirectory)/test_src_test.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_test_pr1.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_test_suite.c$(ObjectSuffix) $(IntermediateDirectory)/src_main.c$(ObjectSuffix) 
+Objects0=$(IntermediateDirectory)/test_src_test.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_test_pr1.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_test_suite.c$(ObjectSuffix) $(IntermediateDirectory)/test_src_test_csv.c$(ObjectSuffix) $(IntermediateDirectory)/src_main.c$(ObjectSuffix) 
 
 
 
@@ -117,6 +117,14 @@ $(IntermediateDirectory)/test_src_test_suite.c$(DependSuffix): test/src/test_sui
 $(IntermediateDirectory)/test_src_test_suite.c$(PreprocessSuffix): test/src/test_suite.c
 	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/test_src_test_suite.c$(PreprocessSuffix) test/src/test_suite.c
 
+$(IntermediateDirectory)/test_src_test_csv.c$(ObjectSuffix): test/src/test_csv.c $(IntermediateDirectory)/test_src_test_csv.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/PR1/UOC20241/test/src/test_csv.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/test_src_test_csv.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/test_src_test_csv.c$(DependSuffix): test/src/test_csv.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/test_src_test_csv.c$(ObjectSuffix) -MF$(IntermediateDirectory)/test_src_test_csv.c$(DependSuffix) -MM test/src/test_csv.c
+
+$(IntermediateDirectory)/test_src_test_csv.c$(PreprocessSuffix): test/src/test_csv.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/test_src_test_csv.c$(PreprocessSuffix) test/src/test_csv.c
+
 $(IntermediateDirectory)/src_main.c$(ObjectSuffix): src/main.c $(IntermediateDirectory)/src_main.c$(DependSuffix)
 	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/PR1/UOC20241/src/main.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_main.c$(ObjectSuffix) $(IncludePath)
 $(IntermediateDirectory)/src_main.c$(DependSuffix): src/main.c
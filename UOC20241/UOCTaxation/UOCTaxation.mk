@@ -62,7 +62,7 @@ AS       := /usr/bin/as
 ## User defined environment variables
 ##
 CodeLiteDir:=/usr/share/codelite
-Objects0=$(IntermediateDirectory)/src_date.c$(ObjectSuffix) $(IntermediateDirectory)/src_api.c$(ObjectSuffix) $(IntermediateDirectory)/src_csv.c$(ObjectSuffix) $(IntermediateDirectory)/src_landlord.c$(ObjectSuffix) $(IntermediateDirectory)/src_tenant.c$(ObjectSuffix) $(IntermediateDirectory)/src_rental_incomes.c$(ObjectSuffix) 
+Objects0=$(IntermediateDirectory)/src_date.c$(ObjectSuffix) $(IntermediateDirectory)/src_api.c$(ObjectSuffix) $(IntermediateDirectory)/src_csv.c$(ObjectSuffix) $(IntermediateDirectory)/src_landlord.c$(ObjectSuffix) $(IntermediateDirectory)/src_tenant.c$(ObjectSuffix) $(IntermediateDirectory)/src_rental_incomes.c$(ObjectSuffix) $(IntermediateDirectory)/src_hash.c$(ObjectSuffix) $(IntermediateDirectory)/src_key.c$(ObjectSuffix) $(IntermediateDirectory)/src_person_id.c$(ObjectSuffix) $(IntermediateDirectory)/src_money.c$(ObjectSuffix) 
 
 
 
@@ -142,6 +142,38 @@ $(IntermediateDirectory)/src_rental_incomes.c$(DependSuffix): src/rental_incomes
 $(IntermediateDirectory)/src_rental_incomes.c$(PreprocessSuffix): src/rental_incomes.c
 	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_rental_incomes.c$(PreprocessSuffix) src/rental_incomes.c
 
+$(IntermediateDirectory)/src_hash.c$(ObjectSuffix): src/hash.c $(IntermediateDirectory)/src_hash.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/PR1/UOC20241/UOCTaxation/src/hash.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_hash.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_hash.c$(DependSuffix): src/hash.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_hash.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_hash.c$(DependSuffix) -MM src/hash.c
+
+$(IntermediateDirectory)/src_hash.c$(PreprocessSuffix): src/hash.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_hash.c$(PreprocessSuffix) src/hash.c
+
+$(IntermediateDirectory)/src_key.c$(ObjectSuffix): src/key.c $(IntermediateDirectory)/src_key.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/PR1/UOC20241/UOCTaxation/src/key.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_key.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_key.c$(DependSuffix): src/key.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_key.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_key.c$(DependSuffix) -MM src/key.c
+
+$(IntermediateDirectory)/src_key.c$(PreprocessSuffix): src/key.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_key.c$(PreprocessSuffix) src/key.c
+
+$(IntermediateDirectory)/src_person_id.c$(ObjectSuffix): src/person_id.c $(IntermediateDirectory)/src_person_id.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/PR1/UOC20241/UOCTaxation/src/person_id.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_person_id.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_person_id.c$(DependSuffix): src/person_id.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_person_id.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_person_id.c$(DependSuffix) -MM src/person_id.c
+
+$(IntermediateDirectory)/src_person_id.c$(PreprocessSuffix): src/person_id.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_person_id.c$(PreprocessSuffix) src/person_id.c
+
+$(IntermediateDirectory)/src_money.c$(ObjectSuffix): src/money.c $(IntermediateDirectory)/src_money.c$(DependSuffix)
+	$(CC) $(SourceSwitch) "/home/uoc/Documents/codelite/workspaces/PR1/UOC20241/UOCTaxation/src/money.c" $(CFLAGS) $(ObjectSwitch)$(IntermediateDirectory)/src_money.c$(ObjectSuffix) $(IncludePath)
+$(IntermediateDirectory)/src_money.c$(DependSuffix): src/money.c
+	@$(CC) $(CFLAGS) $(IncludePath) -MG -MP -MT$(IntermediateDirectory)/src_money.c$(ObjectSuffix) -MF$(IntermediateDirectory)/src_money.c$(DependSuffix) -MM src/money.c
+
+$(IntermediateDirectory)/src_money.c$(PreprocessSuffix): src/money.c
+	$(CC) $(CFLAGS) $(IncludePath) $(PreprocessOnlySwitch) $(OutputSwitch) $(IntermediateDirectory)/src_money.c$(PreprocessSuffix) src/money.c
+
 
 -include $(IntermediateDirectory)/*$(DependSuffix)
 ##
@@ -7,6 +7,7 @@
 #include "tenant.h"
 #include "landlord.h"
 #include "rental_incomes.h"
+#include "person_id.h"
 
 
 // Type that stores all the application data
@@ -28,53 +29,111 @@ const char* api_version();
 // Load data from a CSV file. If reset is true, remove previous data
 tApiError api_loadData(tApiData* data, const char* filename, bool reset);
 
+// Load data from a CSV file, parsing it on several threads. Entries are added in file order, so the
+// result is the same as api_loadData. If reset is true, remove previous data
+tApiError api_loadDataParallel(tApiData* data, const char* filename, bool reset, int numThreads);
+
+// Save all the data into a CSV file with the format accepted by api_loadData
+tApiError api_saveData(const tApiData* data, const char* filename);
+
+// Save all the data into a binary snapshot file
+tApiError api_saveSnapshot(const tApiData* data, const char* filename);
+
+// Load the data of a binary snapshot file. The data structure must be initialized and empty
+tApiError api_loadSnapshot(tApiData* data, const char* filename);
+
+// Get the number of tenants and landlords whose id does not have the right control letter
+int api_invalidIdsCount(const tApiData* data);
+
 // Initialize the data structure
 tApiError api_initData(tApiData* data);
 
 // Add a tenant into the data if it does not exist
 tApiError api_addTenant(tApiData* data, tCSVEntry entry);
 
+// Same as api_addTenant, taking the entry by pointer
+tApiError api_addTenant_ptr(tApiData* data, const tCSVEntry* entry);
+
 // Add a landlord if it does not exist
 tApiError api_addLandlord(tApiData* data, tCSVEntry entry);
 
+// Same as api_addLandlord, taking the entry by pointer
+tApiError api_addLandlord_ptr(tApiData* data, const tCSVEntry* entry);
+
 // Add a property into the properties of an specific landlord
 tApiError api_addProperty(tApiData* data, tCSVEntry entry);
 
+// Same as api_addProperty, taking the entry by pointer
+tApiError api_addProperty_ptr(tApiData* data, const tCSVEntry* entry);
+
 // Add a rental income into a list if the landlord already exists
 tApiError api_addRentalIncome(tApiData* data, tCSVEntry entry);
 
+// Same as api_addRentalIncome, taking the entry by pointer
+tApiError api_addRentalIncome_ptr(tApiData* data, const tCSVEntry* entry);
+
 // Find a rental income by year and landlord document id
 tRentalIncome* rentalIncomes_find(tRentalIncomeList list, int year, const char* document_id);
 
+// Same as rentalIncomes_find, taking the list by pointer
+tRentalIncome* rentalIncomes_find_ptr(const tRentalIncomeList* list, int year, const char* document_id);
+
 // Get the number of tenants registered on the application
 int api_tenantCount(tApiData data);
 
+// Same as api_tenantCount, taking the data by pointer
+int api_tenantCount_ptr(const tApiData* data);
+
 // Get the number of landlords registered on the application
 int api_landlordsCount(tApiData data);
 
+// Same as api_landlordsCount, taking the data by pointer
+int api_landlordsCount_ptr(const tApiData* data);
+
 // Get the number of properties in all landlords registered on the application
 int api_propertiesCount(tApiData data);
 
+// Same as api_propertiesCount, taking the data by pointer
+int api_propertiesCount_ptr(const tApiData* data);
+
 // Get the number of rental incomes registered
 int api_rentalIncomesCount(tApiData data);
 
+// Same as api_rentalIncomesCount, taking the data by pointer
+int api_rentalIncomesCount_ptr(const tApiData* data);
+
 // Free all used memory
 tApiError api_freeData(tApiData* data);
 
 // Add a new entry
 tApiError api_addDataEntry(tApiData* data, tCSVEntry entry);
 
+// Same as api_addDataEntry, taking the entry by pointer
+tApiError api_addDataEntry_ptr(tApiData* data, const tCSVEntry* entry);
+
 // Get landlord data
 tApiError api_getLandlord(tApiData data, const char *id, tCSVEntry *entry);
 
+// Same as api_getLandlord, taking the data by pointer
+tApiError api_getLandlord_ptr(const tApiData* data, const char *id, tCSVEntry *entry);
+
 // Get the rental income by year of a landlord
 tApiError api_getRentalIncome(tApiData data, int year, const char* id, tCSVEntry *entry);
 
+// Same as api_getRentalIncome, taking the data by pointer
+tApiError api_getRentalIncome_ptr(const tApiData* data, int year, const char* id, tCSVEntry *entry);
+
 // Get registered properties
 tApiError api_getProperties(tApiData data, tCSVData *properties);
 
+// Same as api_getProperties, taking the data by pointer
+tApiError api_getProperties_ptr(const tApiData* data, tCSVData *properties);
+
 // Get registered rental incomes
 tApiError api_getRentalIncomes(tApiData data, tCSVData *rentalIncomes);
 
+// Same as api_getRentalIncomes, taking the data by pointer
+tApiError api_getRentalIncomes_ptr(const tApiData* data, tCSVData *rentalIncomes);
+
 
 #endif // __UOCTAXATION_API__H
\ No newline at end of file
@@ -2,31 +2,117 @@
 #define __CSV_H__
 
 #include <stdbool.h>
+#include <stddef.h>
 #define CSV_SEPARATOR_CHAR ;
 
+// Default size of the buffer of a CSV reader
+#define CSV_READER_BUFFER_SIZE 65536
+
+// Buffer sizes for writers
+#define CSV_WRITER_BUFFER_SIZE (1 << 20)
+#define CSV_WRITER_MIN_BUFFER 64
+
+// Types of entries recognised while parsing
+typedef enum _tCSVEntryType {
+    CSV_TYPE_UNKNOWN = 0,
+    CSV_TYPE_TENANT,
+    CSV_TYPE_LANDLORD,
+    CSV_TYPE_PROPERTY,
+    CSV_TYPE_RENTAL_INCOME,
+    CSV_NUM_TYPES
+} tCSVEntryType;
+
+// Slice of the entry line that holds one field
+typedef struct _tCSVField {
+    int offset;
+    int length;
+} tCSVField;
+
 // Store one entry from a CSV file
 typedef struct _tCSVEntry {
     int numFields;
+    tCSVEntryType typeId;
+    // Known types point to a shared name, other types are stored with the entry
     char* type;
-    char** fields;    
+    char** fields;
+    // View mode: a single owned copy of the line, fields are slices into it
+    char* line;
+    tCSVField* views;
+    // Bytes owned by the entry. Zero when the memory belongs to an arena
+    int capacity;
 } tCSVEntry;
 
+// Chunk of memory shared by all the entries of a tCSVData in arena mode
+typedef struct _tCSVChunk {
+    struct _tCSVChunk* next;
+    int size;
+    int used;
+} tCSVChunk;
+
 // Store the content of a CSV file
 typedef struct _tCSVData {
     tCSVEntry *entries;
     int count;
+    int capacity;
     bool isValid;
+    // Arena mode: the memory of the entries is carved from these chunks
+    bool useArena;
+    tCSVChunk* chunks;
 } tCSVData;
 
+// Read-only content of a whole CSV file mapped in memory
+typedef struct _tCSVFile {
+    const char* data;
+    size_t size;
+} tCSVFile;
+
+// Pull-based reader of the records of a CSV file, using a reusable buffer
+typedef struct _tCSVReader {
+    int fd;
+    bool ownsFd;
+    char* buffer;
+    int bufferSize;
+    // Unread bytes of the buffer
+    int start;
+    int end;
+    bool eof;
+    // Offset in the file of the first byte of the buffer
+    long long offset;
+    // Position of the last record read
+    long long recordOffset;
+    int recordLine;
+    int lines;
+    // Last record read
+    tCSVEntry entry;
+} tCSVReader;
+
+// Writer of CSV records to a file, using a large buffer
+typedef struct _tCSVWriter {
+    int fd;
+    bool ownsFd;
+    char* buffer;
+    int bufferSize;
+    int used;
+    // Number of fields written on the current record
+    int numFields;
+    bool failed;
+} tCSVWriter;
+
 // Initialize the tCSVData structure
 void csv_init(tCSVData* data);
 
+// Initialize the tCSVData structure in arena mode, where all the entries share a few large chunks of memory
+void csv_initArena(tCSVData* data);
+
 // Initialize the tCSVEntry structure
 void csv_initEntry(tCSVEntry* entry);
 
 // Parse the contents of a CSV file
 void csv_parse(tCSVData* data, const char* input, const char* type);
 
+// Parse all the lines of a buffer of given length, skipping empty lines
+void csv_parseBuffer(tCSVData* data, const char* input, size_t length, const char* type);
+
 // Add a new entry to the CSV Data
 void csv_addStrEntry(tCSVData* data, const char* entry, const char* type);
 
@@ -37,8 +123,14 @@ void csv_print(tCSVData data);
 void csv_printEntry(tCSVEntry entry);
 
 // Parse the contents of a CSV line   "f1;f2;f3" =>  field_0 = f1, field_1 = f2, field_2 = f3
+// It is parsed as a view entry, so it splits as csv_parseEntryView and stops at the first new line
 void csv_parseEntry(tCSVEntry* entry, const char* input, const char* type);
 
+// Parse a CSV line of given length as a view entry, stopping at the first new line. The entry keeps
+// a single copy of the line and reuses its memory if it was already used as a view entry.
+// Returns the length of the parsed line, without the new line character
+int csv_parseEntryView(tCSVEntry* entry, const char* input, int length, const char* type);
+
 // Get the number of entries
 bool csv_isValid(tCSVData data);
 
@@ -52,7 +144,13 @@ void csv_freeEntry(tCSVEntry* entry);
 int csv_numEntries(tCSVData data);
 
 // Get the type of information contained in the entry
-const char* csv_getType(tCSVEntry* entry);
+const char* csv_getType(const tCSVEntry* entry);
+
+// Get the type of the entry as one of the known types
+tCSVEntryType csv_getTypeId(const tCSVEntry* entry);
+
+// Get the type of entry with the given name, CSV_TYPE_UNKNOWN if it is not one of the known types
+tCSVEntryType csv_internType(const char* name, int length);
 
 // Get an entry from the CSV data
 tCSVEntry* csv_getEntry(tCSVData data, int position);
@@ -60,15 +158,106 @@ tCSVEntry* csv_getEntry(tCSVData data, int position);
 // Get the number of fields for a given entry
 int csv_numFields(tCSVEntry entry);
 
-// Get a field from the given entry as integer
+// Get the length of a field from the given entry
+int csv_getFieldLength(tCSVEntry entry, int position);
+
+// Check if any field of the entry is empty, as in "f1;;f3". Every field of the known types is required
+bool csv_hasEmptyField(const tCSVEntry* entry);
+
+// Get a field from the given entry as integer. Returns 0 if the field is not a valid integer, use
+// csv_tryGetAsInteger to tell it apart
 int csv_getAsInteger(tCSVEntry entry, int position);
 
 // Get a field from the given entry as string. The value is copied to the provided buffer with provided maximum length
 void csv_getAsString(tCSVEntry entry, int position, char* buffer, int length);
 
-// Get a field from the given entry as integer
+// Get a field from the given entry as real. Returns 0 if the field is not a valid decimal number, use
+// csv_tryGetAsReal to tell it apart
 float csv_getAsReal(tCSVEntry entry, int position);
 
+// Get a field from the given entry as integer. Returns false if the field is not a valid integer
+bool csv_tryGetAsInteger(tCSVEntry entry, int position, int* value);
+
+// Get a field from the given entry as real. Returns false if the field is not a valid decimal number
+bool csv_tryGetAsReal(tCSVEntry entry, int position, float* value);
+
+// Get a decimal amount from the given entry as integer cents. Returns false if the field is not a valid amount
+bool csv_tryGetAsCents(tCSVEntry entry, int position, long long* cents);
+
+// Same accessors taking the entry by pointer, which avoids copying it on every call
+int csv_numFields_ptr(const tCSVEntry* entry);
+int csv_getFieldLength_ptr(const tCSVEntry* entry, int position);
+int csv_getAsInteger_ptr(const tCSVEntry* entry, int position);
+void csv_getAsString_ptr(const tCSVEntry* entry, int position, char* buffer, int length);
+float csv_getAsReal_ptr(const tCSVEntry* entry, int position);
+bool csv_tryGetAsInteger_ptr(const tCSVEntry* entry, int position, int* value);
+bool csv_tryGetAsReal_ptr(const tCSVEntry* entry, int position, float* value);
+bool csv_tryGetAsCents_ptr(const tCSVEntry* entry, int position, long long* cents);
+
+// Parse an integer "[+-]digits" of given length, independent of the locale. Returns false and sets 
+// the value to 0 if it is not valid
+bool csv_parseInteger(const char* text, int length, int* value);
+
+// Parse a decimal number "[+-]digits[.digits]" of given length, independent of the locale. Returns false and 
+// sets the value to 0 if it is not valid
+bool csv_parseReal(const char* text, int length, double* value);
+
+// Parse a decimal amount "[+-]digits[.digits]" of given length as integer cents, rounded to the nearest cent. 
+// Returns false if it is not valid
+bool csv_parseCents(const char* text, int length, long long* cents);
+
+// Map a whole CSV file in memory for reading. Returns false if the file cannot be mapped
+bool csv_openFile(tCSVFile* file, const char* filename);
+
+// Release a CSV file mapped in memory
+void csv_closeFile(tCSVFile* file);
+
+// Start reading the records of a file with a buffer of the given size. Returns false if the file cannot be opened
+bool csv_readerOpen(tCSVReader* reader, const char* filename, int bufferSize);
+
+// Start reading the records of an open file descriptor with a buffer of the given size
+void csv_readerOpenFd(tCSVReader* reader, int fd, int bufferSize);
+
+// Read the next record, using the first field as type if type is NULL. Lines longer than the buffer 
+// make it grow. Empty lines are skipped. Returns NULL when there are no more records
+tCSVEntry* csv_readerNext(tCSVReader* reader, const char* type);
+
+// Get the offset in bytes of the last record read
+long long csv_readerOffset(tCSVReader* reader);
+
+// Get the line number of the last record read, starting at 1
+int csv_readerLine(tCSVReader* reader);
+
+// Stop reading and release the reader
+void csv_readerClose(tCSVReader* reader);
+
+// Start writing records to a file with a buffer of the given size. Returns false if the file cannot be created
+bool csv_writerOpen(tCSVWriter* writer, const char* filename, int bufferSize);
+
+// Start writing records to an open file descriptor with a buffer of the given size
+void csv_writerOpenFd(tCSVWriter* writer, int fd, int bufferSize);
+
+// Write a text field. The format has no quoting, so the text cannot contain separators or new lines
+void csv_writeString(tCSVWriter* writer, const char* value);
+
+// Write an integer field
+void csv_writeInteger(tCSVWriter* writer, long long value);
+
+// Write a decimal field with the given number of decimals, rounded to the nearest value
+void csv_writeReal(tCSVWriter* writer, double value, int decimals);
+
+// Write a date field as dd/mm/yyyy
+void csv_writeDate(tCSVWriter* writer, int day, int month, int year);
+
+// Finish the current record
+void csv_writeEndRecord(tCSVWriter* writer);
+
+// Write the buffered records to the file. Returns false if any write failed
+bool csv_writerFlush(tCSVWriter* writer);
+
+// Stop writing and release the writer. Returns false if any write failed
+bool csv_writerClose(tCSVWriter* writer);
+
 // Compare if two entries are the same
 bool csv_equalsEntry(tCSVEntry entry1, tCSVEntry entry2);
 
@@ -14,7 +14,10 @@ enum _tApiError
     E_LANDLORD_NOT_FOUND = -7, // Landlord not found
     E_TENANT_DUPLICATED = -8, // Tenant duplicated
     E_RENTAL_INCOME_NOT_FOUND = -9, // Rental income not found
-    E_PROPERTY_DUPLICATED = -10 // Property duplicated
+    E_PROPERTY_DUPLICATED = -10, // Property duplicated
+    E_INVALID_SNAPSHOT = -11, // Snapshot file is not valid
+    E_FILE_WRITE_ERROR = -12, // File cannot be written
+    E_RENTAL_INCOME_DUPLICATED = -13 // Rental income duplicated
 };
 
 // Define an error type
@@ -0,0 +1,40 @@
+#ifndef __HASH_H__
+#define __HASH_H__
+#include <stdbool.h>
+#include "key.h"
+
+// Slot of a hash index. Empty slots have a negative position
+typedef struct _tHashSlot {
+    tKey key;
+    int position;
+    int subposition;
+} tHashSlot;
+
+// Open addressing hash index from a packed key to a position in an array
+typedef struct _tHashIndex {
+    tHashSlot* slots;
+    int capacity;
+    // Number of bits of the position of a slot, so capacity is 2^bits
+    int bits;
+    int count;
+} tHashIndex;
+
+// Initialize an empty index
+void hashIndex_init(tHashIndex* index);
+
+// Add a key with its position. Returns false if the key already exists
+bool hashIndex_add(tHashIndex* index, tKey key, int position, int subposition);
+
+// Make room for count keys, so they can be added without placing again the existing ones
+void hashIndex_reserve(tHashIndex* index, int count);
+
+// Find the slot of a key. Returns NULL if it does not exist, which is always the case of KEY_INVALID
+tHashSlot* hashIndex_find(const tHashIndex* index, tKey key);
+
+// Remove all the keys, keeping the memory
+void hashIndex_clear(tHashIndex* index);
+
+// Release the index
+void hashIndex_free(tHashIndex* index);
+
+#endif // __HASH_H__
@@ -0,0 +1,26 @@
+#ifndef __KEY_H__
+#define __KEY_H__
+#include <stdbool.h>
+#include <stdint.h>
+
+// Maximum length of a text that can be packed in a key
+#define KEY_MAX_LENGTH 9
+
+// Key of a text that cannot be packed. Valid keys never have the highest bit set
+#define KEY_INVALID UINT64_MAX
+
+// Identifier packed in an integer, 7 bits per ASCII character with the first character in the highest bits and
+// zeros after the end of the text. Two keys are equal if their texts are equal, and they compare as integers
+// in the same order as their texts compare with strcmp
+typedef uint64_t tKey;
+
+// Pack a text in a key. Returns KEY_INVALID if it is longer than KEY_MAX_LENGTH or it is not ASCII
+tKey key_pack(const char* text);
+
+// Unpack a key into a buffer of at least KEY_MAX_LENGTH + 1 characters
+void key_unpack(tKey key, char* buffer);
+
+// Hash of a key in the range [0, 2^bits), taken from the highest bits of the product. bits is from 1 to 32
+unsigned int key_hash(tKey key, int bits);
+
+#endif // __KEY_H__
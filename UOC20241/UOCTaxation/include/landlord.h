@@ -2,12 +2,12 @@
 #define __TAXATION_H__
 #include "csv.h"
 #include "tenant.h"
+#include "hash.h"
 
 ///////////////////////////
-#define MAX_PROPERTIES 80
 #define MAX_NAME 15
 #define MAX_STREET 25
-#define AMOUNT_NO_RENT 150.0
+#define AMOUNT_NO_RENT MONEY_UNITS(150)
 
 #define NUM_FIELDS_LANDLORD 3
 #define NUM_FIELDS_PROPERTY 4
@@ -24,20 +24,32 @@ typedef struct _tProperty {
 } tProperty;
 
 typedef struct _tProperties {
-    tProperty elems[MAX_PROPERTIES];
+    tProperty* elems;
     int count;
+    int capacity;
 } tProperties;
 
 typedef struct _tLandlord {
     char *name;
     char id[MAX_PERSON_ID + 1];
-    float tax;
+    tMoney tax;
     tProperties properties;
 } tLandlord;
 
 typedef struct _tLandlords {
     tLandlord *elems;
+    // Columns with the packed id, the tax and the name of each landlord, so scans touch only the bytes they
+    // need. The functions of the landlords keep them in sync with the elements, and landlords_reindex builds
+    // them again after the elements are changed by hand
+    tKey *ids;
+    tMoney *taxes;
+    char **names;
     int count;
+    int capacity;
+    // Position of each landlord by id
+    tHashIndex index;
+    // Position of the landlord and the property of each cadastral reference
+    tHashIndex properties;
 } tLandlords;
 
 //////////////////////////////////
@@ -49,6 +61,9 @@ void properties_init(tProperties* data);
 // Get the number of properties
 int properties_len(tLandlord data);
 
+// Release the properties
+void properties_free(tProperties* data);
+
 // Initialize the landlords data
 void landlords_init(tLandlords* data);
 
@@ -58,18 +73,50 @@ int landlords_len(tLandlords data);
 // Get the number of properties of all landlords
 int landlords_propertiesCount(tLandlords data);
 
+// Get the tax of the landlord in the given position
+tMoney landlords_tax(const tLandlords* data, int index);
+
+// Add an amount to the tax of the landlord in the given position
+void landlords_addTax(tLandlords* data, int index, tMoney amount);
+
+// Get the packed id of the landlord in the given position
+tKey landlords_key(const tLandlords* data, int index);
+
+// Get the name of the landlord in the given position
+const char* landlords_name(const tLandlords* data, int index);
+
+// Get the sum of the tax of all landlords
+tMoney landlords_totalTax(const tLandlords* data);
+
 // Initialize a landlord
 void landlord_init(tLandlord* data);
 
-// Parse input from CSVEntry
-void landlord_parse(tLandlord* data, tCSVEntry entry);
+// Parse input from CSVEntry. Returns false if a field is empty, or a numeric field or the id is not a DNI or NIE
+// with the right control letter
+bool landlord_parse(tLandlord* data, tCSVEntry entry);
+
+// Same as landlord_parse, taking the entry by pointer
+bool landlord_parse_ptr(tLandlord* data, const tCSVEntry* entry);
 
 // Release a landlord
 void landlord_free(tLandlord* data);
 
-// Add a new tenant
+// Add a new tenant. Landlords whose id cannot be packed in a key are not added
 void landlords_add(tLandlords* data, tLandlord tenant);
 
+// Add a new landlord, taking the ownership of its name and properties instead of copying them. Returns false 
+// if the landlord already exists or its id cannot be packed in a key, leaving it unchanged
+bool landlords_add_move(tLandlords* data, tLandlord* landlord);
+
+// Make room for at least capacity landlords and their index, so they can be added without allocating memory
+void landlords_reserve(tLandlords* data, int capacity);
+
+// Make room in the index of properties for count properties of all the landlords
+void landlords_reserveProperties(tLandlords* data, int count);
+
+// Release the memory reserved for landlords that have not been added, for instance after removing many of them
+void landlords_shrink(tLandlords* data);
+
 //Remove a landlord
 void landlords_del(tLandlords* data, char* id);
 
@@ -79,8 +126,11 @@ void landlords_free(tLandlords* data);
 // Copy the data from the source to destination
 void landlords_cpy(tLandlords* destination, tLandlords source);
 
-// Parse input from CSVEntry
-void property_parse(tProperty* data, tCSVEntry entry);
+// Parse input from CSVEntry. Returns false if a field is empty, or a numeric field or an id is not valid
+bool property_parse(tProperty* data, tCSVEntry entry);
+
+// Same as property_parse, taking the entry by pointer
+bool property_parse_ptr(tProperty* data, const tCSVEntry* entry);
 
 // Add a new property
 void landlord_add_property(tLandlords* data, tProperty property);
@@ -91,12 +141,18 @@ void landlords_process_tenant(tLandlords* data, tTenant tenant);
 // Get landlord data in a string
 void landlord_get(tLandlords data, int index, char* buffer);
 
+// Same as landlord_get, taking the landlords by pointer
+void landlord_get_ptr(const tLandlords* data, int index, char* buffer);
+
 // Get a property data in a string
 void property_get(tLandlord data, int index, char* buffer);
 
 // returns true if field tax of expected[index] is greater than the one in declarant[index]
 bool mismatch_tax_declaration(tLandlords expected, tLandlords declarant, int index);
 
+// Same as mismatch_tax_declaration, taking the landlords by pointer
+bool mismatch_tax_declaration_ptr(const tLandlords* expected, const tLandlords* declarant, int index);
+
 /////////////////////////////////////
 // Aux methods
 /////////////////////////////////////
@@ -104,19 +160,37 @@ bool mismatch_tax_declaration(tLandlords expected, tLandlords declarant, int ind
 // [AUX METHOD] Return the position of a property entry with provided information. -1 if it does not exist
 int properties_find(tProperties data, const char* cadastral_ref);
 
+// [AUX METHOD] Same as properties_find, taking the properties by pointer
+int properties_find_ptr(const tProperties* data, const char* cadastral_ref);
+
 // [AUX METHODS] Copy the data from the source to destination
 void property_cpy(tProperty* destination, tProperty source);
 
 // [AUX METHODS] returns the position of a landlord that has a property with that cadastral ref
 int landlords_find_by_cadastral_ref(tLandlords data, const char* cadastral_ref);
 
+// [AUX METHOD] Return the position of the landlord that has a property with that cadastral ref, and the 
+// position of the property in property_idx. -1 if it does not exist
+int landlords_find_property(tLandlords data, const char* cadastral_ref, int* property_idx);
+
+// [AUX METHOD] Same as landlords_find_property, taking the landlords by pointer
+int landlords_find_property_ptr(const tLandlords* data, const char* cadastral_ref, int* property_idx);
+
 // [AUX METHOD] Return the position of a landl entry with that landlord id. -1 if it does not exist
 int landlords_find(tLandlords data, const char* landlord_id);
 
+// [AUX METHOD] Same as landlords_find, taking the landlords by pointer
+int landlords_find_ptr(const tLandlords* data, const char* landlord_id);
+
+// [AUX METHOD] Build again the indexes of the landlords and their properties, and the columns of the
+// landlords, from the elements.
+// Returns false if an id or a cadastral reference cannot be packed in a key, leaving it out of the indexes
+bool landlords_reindex(tLandlords* data);
+
 // [AUX METHODS] Copy the data from the source to destination
 void landlord_cpy(tLandlord* destination, tLandlord source);
 
-// [AUX METHODS] Copy the properties from sources to destination
+// [AUX METHODS] Copy the properties from sources to destination. The destination must not have any properties
 void properties_cpy(tProperties *destination, tProperties source);
 
 ////////////////////////////////////////////
@@ -0,0 +1,25 @@
+#ifndef __MONEY_H__
+#define __MONEY_H__
+
+// Number of cents in a unit of money
+#define MONEY_CENTS 100
+
+// Amount of money in 64-bit integer cents, so sums and the tax formula are exact
+typedef long long tMoney;
+
+// Convert an amount in units to cents
+#define MONEY_UNITS(units) ((tMoney) (units) * MONEY_CENTS)
+
+// Get the given percentage of an amount, rounded half away from zero to the nearest cent
+tMoney money_percent(tMoney amount, int percent);
+
+// Get an amount as a real number of units, to print or write it
+double money_toReal(tMoney amount);
+
+// Number of amounts gathered in a buffer before summing them with money_sum
+#define MONEY_BATCH_SIZE 256
+
+// Sum count amounts, with AVX2 or SSE2 when the CPU supports them
+tMoney money_sum(const tMoney* values, int count);
+
+#endif // __MONEY_H__
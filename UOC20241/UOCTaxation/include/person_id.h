@@ -0,0 +1,16 @@
+#ifndef __PERSON_ID_H__
+#define __PERSON_ID_H__
+#include <stdbool.h>
+
+// Length of a DNI or NIE: 8 digits (or X, Y, Z and 7 digits) and a control letter
+#define PERSON_ID_LENGTH 9
+
+// Check if an id is a DNI or NIE with the right control letter
+bool personId_isValid(const char* id);
+
+// Check the control letter of a block of count ids of PERSON_ID_LENGTH characters each, stored one after the
+// other without terminators. The result of each one is stored in valid. Returns the number of valid ids.
+// Uses AVX2 or SSE2 when the CPU supports them
+int personId_validateBlock(const char* ids, int count, bool* valid);
+
+#endif // __PERSON_ID_H__
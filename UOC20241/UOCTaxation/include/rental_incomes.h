@@ -11,37 +11,102 @@
 typedef struct _tRentalIncome {
     tLandlord *landlord;
     int year;
-    float totalIncome;
+    tMoney totalIncome;
 } tRentalIncome;
 
-typedef struct _tRentalIncomeListNode {
-    tRentalIncome elem;
-    struct _tRentalIncomeListNode *next;
-} tRentalIncomeListNode;
+// Key of a rental income, used to keep the list sorted. The landlord id is packed
+typedef struct _tRentalIncomeKey {
+    int year;
+    tKey landlord;
+} tRentalIncomeKey;
+
+// Number of elements of a leaf of the list, and of children of an inner node
+#define RENTAL_INCOME_LEAF_SIZE 64
+#define RENTAL_INCOME_NODE_SIZE 32
+
+// Leaf of the list: a run of elements stored in contiguous memory, in order. The keys are stored apart
+// from the elements so searches touch as little memory as possible
+typedef struct _tRentalIncomeLeaf {
+    tRentalIncomeKey keys[RENTAL_INCOME_LEAF_SIZE];
+    tRentalIncome elems[RENTAL_INCOME_LEAF_SIZE];
+    int count;
+    struct _tRentalIncomeLeaf *next;
+} tRentalIncomeLeaf;
 
+// Inner node of the list, with the smallest key and the number of elements under each child
+typedef struct _tRentalIncomeNode {
+    tRentalIncomeKey keys[RENTAL_INCOME_NODE_SIZE];
+    int sizes[RENTAL_INCOME_NODE_SIZE];
+    void *children[RENTAL_INCOME_NODE_SIZE];
+    int count;
+} tRentalIncomeNode;
+
+// Rental incomes sorted by year and landlord id, stored in a B+tree of wide leaves. The root is a leaf
+// when height is 0, and an inner node otherwise
 typedef struct _tRentalIncomeList {
-    tRentalIncomeListNode *first;
+    void *root;
+    int height;
+    tRentalIncomeLeaf *first;
     int count;
+    // In bulk mode elements are appended unordered to these arrays, and sorted once when the mode ends
+    tRentalIncome *bulkElems;
+    tRentalIncomeKey *bulkKeys;
+    int bulkCount;
+    int capacity;
+    bool bulk;
 } tRentalIncomeList;
 
-// Parse a rental income
-void rentalIncome_parse(tRentalIncome* data, tCSVEntry entry);
+// Parse a rental income. Returns false if a field is empty or a numeric field is not valid
+bool rentalIncome_parse(tRentalIncome* data, tCSVEntry entry);
+
+// Same as rentalIncome_parse, taking the entry by pointer
+bool rentalIncome_parse_ptr(tRentalIncome* data, const tCSVEntry* entry);
 
 // Initialize a rental incomes list
 void rentalIncomes_init(tRentalIncomeList *list);
 
-// Check if the linked list is empty
+// Check if the list is empty
 bool rentalIncomes_isEmpty(tRentalIncomeList list);
 
 // Return the number of elements of the list
 int rentalIncomes_len(tRentalIncomeList list);
 
-// Create and initialize a node of tRentalIncomeListNode
-tRentalIncomeListNode* rentalIncomes_createNode(tRentalIncome rentalIncome);
+// Get the element at the given position of the list, in O(log n). It is valid until the list is modified
+tRentalIncome* rentalIncomes_get(tRentalIncomeList list, int index);
+
+// Same as rentalIncomes_get, taking the list by pointer
+tRentalIncome* rentalIncomes_get_ptr(const tRentalIncomeList* list, int index);
 
-// Add an element into the linked list
+// Get the elements stored one after the other from the given position, up to the end of their leaf, and
+// their keys if keys is not NULL. Returns their number. Scans walk the list one run at a time
+int rentalIncomes_getRun(const tRentalIncomeList* list, int index, tRentalIncome** elems, const tRentalIncomeKey** keys);
+
+// Add an element into the list, ordered by year and landlord id. Returns E_RENTAL_INCOME_DUPLICATED
+// if there is already an element with the same year and landlord. It costs O(log n) at any position,
+// moving at most the elements of a leaf. Loads of many elements use the bulk mode instead
 tApiError rentalIncomes_add(tRentalIncomeList *list, tRentalIncome rentalIncome);
 
+// Find the position of the element with the given year and landlord id. Returns -1 if it does not exist
+int rentalIncomes_position(tRentalIncomeList list, int year, const char* landlord_id);
+
+// Same as rentalIncomes_position, taking the list by pointer
+int rentalIncomes_position_ptr(const tRentalIncomeList* list, int year, const char* landlord_id);
+
+// Get the sum of the total income of all the elements
+tMoney rentalIncomes_total(const tRentalIncomeList* list);
+
+// Make room for at least capacity elements added in bulk mode, so they can be appended without allocating memory
+void rentalIncomes_reserve(tRentalIncomeList *list, int capacity);
+
+// Start adding elements in bulk mode. Until the mode ends, elements are appended without looking for
+// duplicates and the list cannot be searched
+void rentalIncomes_beginBulk(tRentalIncomeList *list);
+
+// Sort the elements added in bulk mode, merge them with the rest and end the mode, rebuilding the list
+// with full leaves. If an element has the same year and landlord as a previous one, only the first is
+// kept and E_RENTAL_INCOME_DUPLICATED is returned
+tApiError rentalIncomes_endBulk(tRentalIncomeList *list);
+
 // Release the list
 void rentalIncomes_free(tRentalIncomeList *list);
 
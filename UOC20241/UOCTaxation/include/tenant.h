@@ -3,6 +3,9 @@
 
 #include "date.h"
 #include "csv.h"
+#include "hash.h"
+#include "person_id.h"
+#include "money.h"
 
 #define MAX_PERSON_ID 9
 #define MAX_CADASTRAL_REF 7
@@ -14,7 +17,7 @@ typedef struct _tTenant {
     tDate end_date;
     char tenant_id[MAX_PERSON_ID + 1];
     char *name;
-    float rent;
+    tMoney rent;
     int age;
     char cadastral_ref[MAX_CADASTRAL_REF + 1];
 } tTenant;
@@ -22,6 +25,9 @@ typedef struct _tTenant {
 typedef struct _tTenantData {
     tTenant *elems;
     int count;
+    int capacity;
+    // Position of each tenant by id
+    tHashIndex index;
 } tTenantData;
 
 // Initialize a tenant
@@ -30,8 +36,12 @@ void tenant_init(tTenant *tenant);
 // Copy a tenant
 void tenant_cpy(tTenant *dst, tTenant src);
 
-// Parse input from CSVEntry
-void tenant_parse(tTenant* data, tCSVEntry entry);
+// Parse input from CSVEntry. Returns false if a field is empty, or a numeric field or the id is not a DNI or NIE
+// with the right control letter
+bool tenant_parse(tTenant* data, tCSVEntry entry);
+
+// Same as tenant_parse, taking the entry by pointer
+bool tenant_parse_ptr(tTenant* data, const tCSVEntry* entry);
 
 // Release a tenant
 void tenant_free(tTenant *tenant);
@@ -42,12 +52,29 @@ void tenantData_init(tTenantData *data);
 // Return the number of tenants
 int tenantData_len(tTenantData tenants);
 
-// Add a tenant to the data
+// Add a tenant to the data. Tenants whose id cannot be packed in a key are not added
 void tenantData_add(tTenantData *data, tTenant tenant);
 
+// Add a tenant to the data, taking the ownership of its memory instead of copying it. Returns false if the
+// tenant already exists or its id cannot be packed in a key, leaving it unchanged
+bool tenantData_add_move(tTenantData *data, tTenant *tenant);
+
+// Make room for at least capacity tenants and their index, so they can be added without allocating memory
+void tenantData_reserve(tTenantData *data, int capacity);
+
+// Release the memory reserved for tenants that have not been added
+void tenantData_shrink(tTenantData *data);
+
 // Find a tenant into the data
 int tenantData_find(tTenantData data, const char* tenant_id);
 
+// Same as tenantData_find, taking the data by pointer
+int tenantData_find_ptr(const tTenantData* data, const char* tenant_id);
+
+// Build again the index of the tenants by id from the elements. Returns false if an id cannot be packed in
+// a key, leaving that tenant out of the index
+bool tenantData_reindex(tTenantData *data);
+
 // Release the tenants data
 void tenantData_free(tTenantData *data);
 
@@ -5,20 +5,179 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
 
-#define FILE_READ_BUFFER_SIZE 2048
+#if defined(__unix__) || defined(__APPLE__)
+#define API_USE_THREADS
+#include <pthread.h>
+#endif
+
+// Maximum number of threads used to parse a file
+#define API_MAX_THREADS 64
+// Minimum size of the part of a file parsed by each thread
+#define API_MIN_CHUNK_SIZE (1 << 20)
+
+// Number of ids validated on each call to the block validator
+#define API_ID_BATCH_SIZE 256
+
+// Count the records of a mapped file before loading it, to reserve the memory of the containers at once
+#define API_PRESIZE_LOAD
+
+// Part of a file parsed by one thread
+typedef struct _tApiChunk {
+    const char* start;
+    size_t size;
+    tCSVData entries;
+} tApiChunk;
+
+// Identification of the snapshot files
+#define API_SNAPSHOT_MAGIC "UOCT"
+#define API_SNAPSHOT_VERSION 2
+#define API_SNAPSHOT_BYTE_ORDER 0x01020304
+// Size of the file buffer used for snapshots
+#define API_SNAPSHOT_BUFFER_SIZE (1 << 16)
+// Initial value of the FNV-1a checksum of a snapshot
+#define API_CHECKSUM_SEED 0xcbf29ce484222325ULL
+
+// Header of a snapshot file. It is followed by the tenants, landlords, rental incomes, properties and names.
+// The records with 64-bit amounts go first, so all of them are aligned in the loaded payload
+typedef struct _tApiSnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t numTenants;
+    uint32_t numLandlords;
+    uint32_t numProperties;
+    uint32_t numRentalIncomes;
+    uint32_t namesSize;
+    uint64_t checksum;
+} tApiSnapshotHeader;
+
+// Tenant stored in a snapshot. The name is an offset in the names
+typedef struct _tApiSnapshotTenant {
+    tDate start_date;
+    tDate end_date;
+    char tenant_id[MAX_PERSON_ID + 1];
+    char cadastral_ref[MAX_CADASTRAL_REF + 1];
+    int64_t rent;
+    int32_t age;
+    uint32_t name;
+} tApiSnapshotTenant;
+
+// Landlord stored in a snapshot. Its properties follow the ones of the previous landlords
+typedef struct _tApiSnapshotLandlord {
+    char id[MAX_PERSON_ID + 1];
+    int64_t tax;
+    uint32_t name;
+    uint32_t numProperties;
+} tApiSnapshotLandlord;
+
+// Rental income stored in a snapshot, with the position of its landlord
+typedef struct _tApiSnapshotRentalIncome {
+    int32_t landlord;
+    int32_t year;
+    int64_t totalIncome;
+} tApiSnapshotRentalIncome;
 
 // Get the API version information
 const char* api_version() {
     return "UOC PP 20241";
 }
 
+// Load data from a buffer with the content of a CSV file
+static tApiError api_loadBuffer(tApiData* data, const char* buffer, size_t size) {
+    tApiError error = E_SUCCESS;
+    const char *pStart, *pLast;
+    tCSVEntry entry;
+    int len;
+    
+    // Walk the lines in place. The entry memory is reused for all the lines
+    csv_initEntry(&entry);
+    pStart = buffer;
+    pLast = buffer + size;
+    while (pStart < pLast && error == E_SUCCESS) {
+        len = csv_parseEntryView(&entry, pStart, (pLast - pStart > INT_MAX) ? INT_MAX : pLast - pStart, NULL);
+        
+        // Skip empty lines
+        if (csv_getType(&entry) != NULL) {
+            // Add this new entry to the api Data
+            error = api_addDataEntry_ptr(data, &entry);
+        }
+        pStart += len + 1;
+    }
+    csv_freeEntry(&entry);
+    
+    return error;
+}
+
+// Count the records of each type in a buffer with the content of a CSV file, and make room for them
+static void api_reserveData(tApiData* data, const char* buffer, size_t size) {
+    int counts[CSV_NUM_TYPES];
+    const char *pStart, *pEnd, *pLast, *pSeparator;
+    
+    // The type is the text before the first separator of each line
+    memset(counts, 0, sizeof(counts));
+    pStart = buffer;
+    pLast = buffer + size;
+    while (pStart < pLast) {
+        pEnd = (const char*) memchr(pStart, '\n', pLast - pStart);
+        if (pEnd == NULL) {
+            pEnd = pLast;
+        }
+        pSeparator = (const char*) memchr(pStart, ';', pEnd - pStart);
+        if (pSeparator != NULL && pSeparator - pStart <= INT_MAX) {
+            counts[csv_internType(pStart, pSeparator - pStart)]++;
+        }
+        pStart = pEnd + 1;
+    }
+    
+    tenantData_reserve(&(data->tenants), data->tenants.count + counts[CSV_TYPE_TENANT]);
+    landlords_reserve(&(data->landlords), data->landlords.count + counts[CSV_TYPE_LANDLORD]);
+    landlords_reserveProperties(&(data->landlords), 
+        landlords_propertiesCount(data->landlords) + counts[CSV_TYPE_PROPERTY]);
+    rentalIncomes_reserve(&(data->rentalIncomes), data->rentalIncomes.count + counts[CSV_TYPE_RENTAL_INCOME]);
+}
+
+// Remove previous data before a load
+static tApiError api_resetData(tApiData* data) {
+    tApiError error;
+    
+    // Remove previous information
+    error = api_freeData(data);
+    if (error != E_SUCCESS) {
+        return error;
+    }
+    
+    // Initialize the data
+    return api_initData(data);
+}
+
+// End the bulk load of rental incomes. Errors of the load take precedence over duplicated incomes
+static tApiError api_endBulk(tApiData* data, tApiError error) {
+    tApiError bulkError;
+    
+    bulkError = rentalIncomes_endBulk(&(data->rentalIncomes));
+    
+    return (error != E_SUCCESS) ? error : bulkError;
+}
+
+// Parse the lines of a chunk into its own entries
+static void* api_parseChunk(void* arg) {
+    tApiChunk* chunk = (tApiChunk*) arg;
+    
+    csv_parseBuffer(&(chunk->entries), chunk->start, chunk->size, NULL);
+    
+    return NULL;
+}
+
 // Load data from a CSV file. If reset is true, remove previous data
 tApiError api_loadData(tApiData* data, const char* filename, bool reset) {
     tApiError error;
-    FILE *fin;    
-    char buffer[FILE_READ_BUFFER_SIZE];
-    tCSVEntry entry;
+    tCSVFile file;
+    tCSVReader reader;
+    tCSVEntry* entry;
     
     // Check input data
     assert( data != NULL );
@@ -26,45 +185,571 @@ tApiError api_loadData(tApiData* data, const char* filename, bool reset) {
     
     // Reset current data    
     if (reset) {
-        // Remove previous information
-        error = api_freeData(data);
+        error = api_resetData(data);
         if (error != E_SUCCESS) {
             return error;
         }
-        
-        // Initialize the data
-        error = api_initData(data);
+    }
+    
+    // Rental incomes are appended unordered, and sorted once at the end
+    rentalIncomes_beginBulk(&(data->rentalIncomes));
+
+    // Map the input file in memory so lines are read in place
+    if (csv_openFile(&file, filename)) {
+#ifdef API_PRESIZE_LOAD
+        api_reserveData(data, file.data, file.size);
+#endif
+        error = api_loadBuffer(data, file.data, file.size);
+        csv_closeFile(&file);
+        return api_endBulk(data, error);
+    }
+    
+    // Otherwise stream the file with a bounded buffer
+    if (!csv_readerOpen(&reader, filename, CSV_READER_BUFFER_SIZE)) {
+        return api_endBulk(data, E_FILE_NOT_FOUND);
+    }
+    error = E_SUCCESS;
+    while (error == E_SUCCESS && (entry = csv_readerNext(&reader, NULL)) != NULL) {
+        // Add this new entry to the api Data
+        error = api_addDataEntry_ptr(data, entry);
+    }
+    csv_readerClose(&reader);
+    
+    return api_endBulk(data, error);
+}
+
+// Load data from a CSV file, parsing it on several threads. Entries are added in file order, so the
+// result is the same as api_loadData. If reset is true, remove previous data
+tApiError api_loadDataParallel(tApiData* data, const char* filename, bool reset, int numThreads) {
+    tApiError error = E_SUCCESS;
+    tCSVFile file;
+    tApiChunk chunks[API_MAX_THREADS];
+    const char *pStart, *pEnd, *pLast;
+    int numChunks;
+    int i, j;
+#ifdef API_USE_THREADS
+    pthread_t threads[API_MAX_THREADS];
+    bool started[API_MAX_THREADS];
+#endif
+    
+    // Check input data
+    assert(data != NULL);
+    assert(filename != NULL);
+    assert(numThreads > 0);
+    
+    // Files that cannot be mapped are loaded sequentially
+    if (!csv_openFile(&file, filename)) {
+        return api_loadData(data, filename, reset);
+    }
+    
+    // Reset current data    
+    if (reset) {
+        error = api_resetData(data);
         if (error != E_SUCCESS) {
+            csv_closeFile(&file);
             return error;
         }
     }
+    
+    // Rental incomes are appended unordered, and sorted once at the end
+    rentalIncomes_beginBulk(&(data->rentalIncomes));
+#ifdef API_PRESIZE_LOAD
+    api_reserveData(data, file.data, file.size);
+#endif
+    
+    // Do not start more threads than chunks of a minimum size
+    numChunks = numThreads;
+    if (numChunks > API_MAX_THREADS) {
+        numChunks = API_MAX_THREADS;
+    }
+    if ((size_t) numChunks > file.size / API_MIN_CHUNK_SIZE + 1) {
+        numChunks = file.size / API_MIN_CHUNK_SIZE + 1;
+    }
+    
+    // Split the file in chunks of similar size that end at a new line
+    pStart = file.data;
+    pLast = file.data + file.size;
+    for (i = 0; i < numChunks; i++) {
+        pEnd = (i == numChunks - 1) ? pLast : file.data + (file.size / numChunks) * (i + 1);
+        if (pEnd < pStart) {
+            pEnd = pStart;
+        }
+        if (pEnd < pLast) {
+            pEnd = (const char*) memchr(pEnd, '\n', pLast - pEnd);
+            pEnd = (pEnd == NULL) ? pLast : pEnd + 1;
+        }
+        chunks[i].start = pStart;
+        chunks[i].size = pEnd - pStart;
+        csv_initArena(&(chunks[i].entries));
+        pStart = pEnd;
+    }
+    
+    // Parse the chunks in parallel. The first one is parsed by this thread
+#ifdef API_USE_THREADS
+    for (i = 1; i < numChunks; i++) {
+        started[i] = (pthread_create(&(threads[i]), NULL, api_parseChunk, &(chunks[i])) == 0);
+    }
+    api_parseChunk(&(chunks[0]));
+    for (i = 1; i < numChunks; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            api_parseChunk(&(chunks[i]));
+        }
+    }
+#else
+    for (i = 0; i < numChunks; i++) {
+        api_parseChunk(&(chunks[i]));
+    }
+#endif
+    
+    // Add the entries in file order, stopping at the first error as api_loadData does
+    for (i = 0; i < numChunks; i++) {
+        for (j = 0; j < csv_numEntries(chunks[i].entries) && error == E_SUCCESS; j++) {
+            error = api_addDataEntry_ptr(data, csv_getEntry(chunks[i].entries, j));
+        }
+        csv_free(&(chunks[i].entries));
+    }
+    csv_closeFile(&file);
+    
+    return api_endBulk(data, error);
+}
+
+// Write the tenants as TENANT records
+static void api_writeTenants(tCSVWriter* writer, const tTenantData* tenants) {
+    int i;
+    
+    for (i = 0; i < tenants->count; i++) {
+        csv_writeString(writer, "TENANT");
+        csv_writeDate(writer, tenants->elems[i].start_date.day, tenants->elems[i].start_date.month, 
+            tenants->elems[i].start_date.year);
+        csv_writeDate(writer, tenants->elems[i].end_date.day, tenants->elems[i].end_date.month, 
+            tenants->elems[i].end_date.year);
+        csv_writeString(writer, tenants->elems[i].tenant_id);
+        csv_writeString(writer, tenants->elems[i].name);
+        csv_writeReal(writer, money_toReal(tenants->elems[i].rent), 2);
+        csv_writeInteger(writer, tenants->elems[i].age);
+        csv_writeString(writer, tenants->elems[i].cadastral_ref);
+        csv_writeEndRecord(writer);
+    }
+}
 
-    // Open the input file
-    fin = fopen(filename, "r");
+// Write the landlords as LANDLORD records. The tax written is the declared one, without the 
+// amount added by each property, so loading the file again gives the same tax
+static void api_writeLandlords(tCSVWriter* writer, const tLandlords* landlords) {
+    int i;
+    
+    for (i = 0; i < landlords->count; i++) {
+        csv_writeString(writer, "LANDLORD");
+        csv_writeString(writer, landlords->elems[i].name);
+        csv_writeString(writer, landlords->elems[i].id);
+        csv_writeReal(writer, money_toReal(landlords_tax(landlords, i) - AMOUNT_NO_RENT * 12 * landlords->elems[i].properties.count), 2);
+        csv_writeEndRecord(writer);
+    }
+}
+
+// Write the properties of all the landlords as PROPERTY records
+static void api_writeProperties(tCSVWriter* writer, const tLandlords* landlords) {
+    tProperty* property;
+    int i, j;
+    
+    for (i = 0; i < landlords->count; i++) {
+        for (j = 0; j < landlords->elems[i].properties.count; j++) {
+            property = &(landlords->elems[i].properties.elems[j]);
+            csv_writeString(writer, "PROPERTY");
+            csv_writeString(writer, property->cadastral_ref);
+            csv_writeString(writer, property->address.street);
+            csv_writeInteger(writer, property->address.number);
+            csv_writeString(writer, property->landlord_id);
+            csv_writeEndRecord(writer);
+        }
+    }
+}
+
+// Write the rental incomes as RENTAL_INCOME records
+static void api_writeRentalIncomes(tCSVWriter* writer, const tRentalIncomeList* rentalIncomes) {
+    tRentalIncome* incomes;
+    const tRentalIncomeKey* keys;
+    char landlord_id[KEY_MAX_LENGTH + 1];
+    int i, j, run;
+    
+    // The list is walked one run of contiguous elements at a time
+    for (i = 0; i < rentalIncomes->count; i += run) {
+        run = rentalIncomes_getRun(rentalIncomes, i, &incomes, &keys);
+        for (j = 0; j < run; j++) {
+            // The landlord pointer is not valid once the landlords have grown, the packed id in the key is
+            key_unpack(keys[j].landlord, landlord_id);
+            csv_writeString(writer, "RENTAL_INCOME");
+            csv_writeInteger(writer, incomes[j].year);
+            csv_writeReal(writer, money_toReal(incomes[j].totalIncome), 2);
+            csv_writeString(writer, landlord_id);
+            csv_writeEndRecord(writer);
+        }
+    }
+}
+
+// Save all the data into a CSV file with the format accepted by api_loadData
+tApiError api_saveData(const tApiData* data, const char* filename) {
+    tCSVWriter writer;
+    
+    // Check input data
+    assert(data != NULL);
+    assert(filename != NULL);
+    
+    if (!csv_writerOpen(&writer, filename, CSV_WRITER_BUFFER_SIZE)) {
+        return E_FILE_WRITE_ERROR;
+    }
+    
+    // Landlords go before the records that refer to them
+    api_writeTenants(&writer, &(data->tenants));
+    api_writeLandlords(&writer, &(data->landlords));
+    api_writeProperties(&writer, &(data->landlords));
+    api_writeRentalIncomes(&writer, &(data->rentalIncomes));
+    
+    if (!csv_writerClose(&writer)) {
+        return E_FILE_WRITE_ERROR;
+    }
+    
+    return E_SUCCESS;
+}
+
+// Update a FNV-1a checksum with a block of bytes
+static uint64_t api_checksum(uint64_t checksum, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*) data;
+    size_t i;
+    
+    for (i = 0; i < size; i++) {
+        checksum = (checksum ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    
+    return checksum;
+}
+
+// Write a block of a snapshot, adding it to the checksum
+static bool api_writeSnapshot(FILE* fout, const void* data, size_t size, uint64_t* checksum) {
+    *checksum = api_checksum(*checksum, data, size);
+    return fwrite(data, 1, size, fout) == size;
+}
+
+// Check that a text field of fixed size stored in a snapshot ends inside the field
+static bool api_snapshotText(const char* text, size_t size) {
+    return memchr(text, '\0', size) != NULL;
+}
+
+// Copy a name stored in a snapshot
+static char* api_snapshotName(const char* names, uint32_t offset) {
+    char* name;
+    size_t len;
+    
+    len = strlen(names + offset) + 1;
+    name = (char*) malloc(len * sizeof(char));
+    assert(name != NULL);
+    memcpy(name, names + offset, len);
+    
+    return name;
+}
+
+// Save all the data into a binary snapshot file
+tApiError api_saveSnapshot(const tApiData* data, const char* filename) {
+    tApiSnapshotHeader header;
+    tApiSnapshotTenant tenant;
+    tApiSnapshotLandlord landlord;
+    tApiSnapshotRentalIncome income;
+    tProperty property;
+    tRentalIncome* pIncome;
+    const tRentalIncomeKey* incomeKeys;
+    tHashSlot* slot;
+    const char* name;
+    FILE* fout;
+    uint32_t names = 0;
+    bool ok;
+    int i, j, run;
+    
+    // Check input data
+    assert(data != NULL);
+    assert(filename != NULL);
+    
+    fout = fopen(filename, "wb");
+    if (fout == NULL) {
+        return E_FILE_WRITE_ERROR;
+    }
+    setvbuf(fout, NULL, _IOFBF, API_SNAPSHOT_BUFFER_SIZE);
+    
+    // The header is written again at the end, once the checksum is known
+    memset(&header, 0, sizeof(tApiSnapshotHeader));
+    memcpy(header.magic, API_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = API_SNAPSHOT_VERSION;
+    header.byteOrder = API_SNAPSHOT_BYTE_ORDER;
+    header.numTenants = data->tenants.count;
+    header.numLandlords = data->landlords.count;
+    header.numProperties = landlords_propertiesCount(data->landlords);
+    header.numRentalIncomes = data->rentalIncomes.count;
+    header.checksum = API_CHECKSUM_SEED;
+    ok = fwrite(&header, sizeof(tApiSnapshotHeader), 1, fout) == 1;
+    
+    // Tenants
+    for (i = 0; i < data->tenants.count && ok; i++) {
+        memset(&tenant, 0, sizeof(tApiSnapshotTenant));
+        tenant.start_date = data->tenants.elems[i].start_date;
+        tenant.end_date = data->tenants.elems[i].end_date;
+        strcpy(tenant.tenant_id, data->tenants.elems[i].tenant_id);
+        strcpy(tenant.cadastral_ref, data->tenants.elems[i].cadastral_ref);
+        tenant.rent = data->tenants.elems[i].rent;
+        tenant.age = data->tenants.elems[i].age;
+        tenant.name = names;
+        name = data->tenants.elems[i].name;
+        names += ((name != NULL) ? strlen(name) : 0) + 1;
+        ok = api_writeSnapshot(fout, &tenant, sizeof(tApiSnapshotTenant), &header.checksum);
+    }
+    
+    // Landlords
+    for (i = 0; i < data->landlords.count && ok; i++) {
+        memset(&landlord, 0, sizeof(tApiSnapshotLandlord));
+        strcpy(landlord.id, data->landlords.elems[i].id);
+        landlord.tax = landlords_tax(&(data->landlords), i);
+        landlord.numProperties = data->landlords.elems[i].properties.count;
+        landlord.name = names;
+        name = landlords_name(&(data->landlords), i);
+        names += ((name != NULL) ? strlen(name) : 0) + 1;
+        ok = api_writeSnapshot(fout, &landlord, sizeof(tApiSnapshotLandlord), &header.checksum);
+    }
+    
+    // Rental incomes, in the order of the list
+    for (i = 0; i < data->rentalIncomes.count && ok; i += run) {
+        run = rentalIncomes_getRun(&(data->rentalIncomes), i, &pIncome, &incomeKeys);
+        for (j = 0; j < run && ok; j++) {
+            memset(&income, 0, sizeof(tApiSnapshotRentalIncome));
+            // The landlord pointer is not valid once the landlords have grown, so it is found by its packed id
+            slot = hashIndex_find(&(data->landlords.index), incomeKeys[j].landlord);
+            ok = slot != NULL;
+            income.landlord = ok ? slot->position : -1;
+            income.year = pIncome[j].year;
+            income.totalIncome = pIncome[j].totalIncome;
+            ok = ok && api_writeSnapshot(fout, &income, sizeof(tApiSnapshotRentalIncome), &header.checksum);
+        }
+    }
+    
+    // Properties of all the landlords
+    for (i = 0; i < data->landlords.count && ok; i++) {
+        for (j = 0; j < data->landlords.elems[i].properties.count && ok; j++) {
+            memset(&property, 0, sizeof(tProperty));
+            property_cpy(&property, data->landlords.elems[i].properties.elems[j]);
+            ok = api_writeSnapshot(fout, &property, sizeof(tProperty), &header.checksum);
+        }
+    }
+    
+    // Names, in the same order as their offsets
+    for (i = 0; i < data->tenants.count && ok; i++) {
+        name = (data->tenants.elems[i].name != NULL) ? data->tenants.elems[i].name : "";
+        ok = api_writeSnapshot(fout, name, strlen(name) + 1, &header.checksum);
+    }
+    for (i = 0; i < data->landlords.count && ok; i++) {
+        name = (landlords_name(&(data->landlords), i) != NULL) ? landlords_name(&(data->landlords), i) : "";
+        ok = api_writeSnapshot(fout, name, strlen(name) + 1, &header.checksum);
+    }
+    
+    // The checksum also covers the header
+    header.namesSize = names;
+    header.checksum = api_checksum(header.checksum, &header, offsetof(tApiSnapshotHeader, checksum));
+    if (ok) {
+        ok = fseek(fout, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(tApiSnapshotHeader), 1, fout) == 1;
+    }
+    ok = (fclose(fout) == 0) && ok;
+    
+    if (!ok) {
+        remove(filename);
+        return E_FILE_WRITE_ERROR;
+    }
+    
+    return E_SUCCESS;
+}
+
+// Load the data of a binary snapshot file. The data structure must be initialized and empty
+tApiError api_loadSnapshot(tApiData* data, const char* filename) {
+    tApiSnapshotHeader header;
+    const tApiSnapshotTenant* tenants;
+    const tApiSnapshotLandlord* landlords;
+    const tProperty* properties;
+    const tApiSnapshotRentalIncome* incomes;
+    const char* names;
+    tRentalIncome income;
+    tTenant* tenant;
+    tLandlord* landlord;
+    FILE* fin;
+    char* payload;
+    long fileSize;
+    size_t size;
+    uint64_t checksum;
+    uint32_t numProperties = 0;
+    uint32_t i;
+    bool valid;
+    
+    // Check input data
+    assert(data != NULL);
+    assert(filename != NULL);
+    assert(data->tenants.count == 0);
+    assert(data->landlords.count == 0);
+    assert(data->rentalIncomes.count == 0);
+    
+    fin = fopen(filename, "rb");
     if (fin == NULL) {
         return E_FILE_NOT_FOUND;
     }
     
-    // Read file line by line
-    while (fgets(buffer, FILE_READ_BUFFER_SIZE, fin)) {
-        // Remove new line character     
-        buffer[strcspn(buffer, "\n\r")] = '\0';
-        
-        csv_initEntry(&entry);
-        csv_parseEntry(&entry, buffer, NULL);
-        // Add this new entry to the api Data
-        error = api_addDataEntry(data, entry);
-        if (error != E_SUCCESS) {
-            return error;
-        }
-        csv_freeEntry(&entry);
+    // Check the header before reading the rest of the file
+    valid = fread(&header, sizeof(tApiSnapshotHeader), 1, fin) == 1 &&
+        memcmp(header.magic, API_SNAPSHOT_MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == API_SNAPSHOT_VERSION && header.byteOrder == API_SNAPSHOT_BYTE_ORDER;
+    size = (size_t) header.numTenants * sizeof(tApiSnapshotTenant) +
+        (size_t) header.numLandlords * sizeof(tApiSnapshotLandlord) +
+        (size_t) header.numProperties * sizeof(tProperty) +
+        (size_t) header.numRentalIncomes * sizeof(tApiSnapshotRentalIncome) + header.namesSize;
+    if (valid) {
+        valid = fseek(fin, 0, SEEK_END) == 0 && (fileSize = ftell(fin)) >= 0 &&
+            (size_t) fileSize == sizeof(tApiSnapshotHeader) + size &&
+            fseek(fin, sizeof(tApiSnapshotHeader), SEEK_SET) == 0;
+    }
+    if (!valid) {
+        fclose(fin);
+        return E_INVALID_SNAPSHOT;
     }
     
+    // Read all the records at once
+    payload = (char*) malloc(size > 0 ? size : 1);
+    if (payload == NULL) {
+        fclose(fin);
+        return E_MEMORY_ERROR;
+    }
+    valid = fread(payload, 1, size, fin) == size;
     fclose(fin);
     
+    tenants = (const tApiSnapshotTenant*) payload;
+    landlords = (const tApiSnapshotLandlord*) (tenants + header.numTenants);
+    incomes = (const tApiSnapshotRentalIncome*) (landlords + header.numLandlords);
+    properties = (const tProperty*) (incomes + header.numRentalIncomes);
+    names = (const char*) (properties + header.numProperties);
+    
+    // Check the checksum, that all the references are inside the file and that the ids can be indexed
+    if (valid) {
+        checksum = api_checksum(API_CHECKSUM_SEED, payload, size);
+        checksum = api_checksum(checksum, &header, offsetof(tApiSnapshotHeader, checksum));
+        valid = checksum == header.checksum && 
+            (header.namesSize == 0 || names[header.namesSize - 1] == '\0');
+    }
+    for (i = 0; i < header.numTenants && valid; i++) {
+        valid = tenants[i].name < header.namesSize && 
+            api_snapshotText(tenants[i].tenant_id, MAX_PERSON_ID + 1) &&
+            api_snapshotText(tenants[i].cadastral_ref, MAX_CADASTRAL_REF + 1) &&
+            key_pack(tenants[i].tenant_id) != KEY_INVALID;
+    }
+    for (i = 0; i < header.numLandlords && valid; i++) {
+        valid = landlords[i].name < header.namesSize && api_snapshotText(landlords[i].id, MAX_PERSON_ID + 1) &&
+            key_pack(landlords[i].id) != KEY_INVALID &&
+            landlords[i].numProperties <= header.numProperties - numProperties;
+        numProperties += landlords[i].numProperties;
+    }
+    valid = valid && numProperties == header.numProperties;
+    for (i = 0; i < header.numProperties && valid; i++) {
+        valid = api_snapshotText(properties[i].cadastral_ref, MAX_CADASTRAL_REF + 1) &&
+            key_pack(properties[i].cadastral_ref) != KEY_INVALID &&
+            api_snapshotText(properties[i].address.street, MAX_STREET) &&
+            api_snapshotText(properties[i].landlord_id, MAX_PERSON_ID + 1);
+    }
+    for (i = 0; i < header.numRentalIncomes && valid; i++) {
+        valid = incomes[i].landlord >= 0 && (uint32_t) incomes[i].landlord < header.numLandlords;
+    }
+    // Rental incomes must be sorted by year and landlord id, without duplicates
+    for (i = 1; i < header.numRentalIncomes && valid; i++) {
+        valid = incomes[i - 1].year < incomes[i].year || (incomes[i - 1].year == incomes[i].year && 
+            strcmp(landlords[incomes[i - 1].landlord].id, landlords[incomes[i].landlord].id) < 0);
+    }
+    if (!valid) {
+        free(payload);
+        return E_INVALID_SNAPSHOT;
+    }
+    
+    // Tenants
+    tenantData_reserve(&(data->tenants), header.numTenants);
+    for (i = 0; i < header.numTenants; i++) {
+        tenant = &(data->tenants.elems[i]);
+        tenant_init(tenant);
+        tenant->start_date = tenants[i].start_date;
+        tenant->end_date = tenants[i].end_date;
+        memcpy(tenant->tenant_id, tenants[i].tenant_id, MAX_PERSON_ID + 1);
+        memcpy(tenant->cadastral_ref, tenants[i].cadastral_ref, MAX_CADASTRAL_REF + 1);
+        tenant->rent = tenants[i].rent;
+        tenant->age = tenants[i].age;
+        tenant->name = api_snapshotName(names, tenants[i].name);
+    }
+    data->tenants.count = header.numTenants;
+    tenantData_reindex(&(data->tenants));
+    
+    // Landlords, with their properties
+    landlords_reserve(&(data->landlords), header.numLandlords);
+    for (i = 0; i < header.numLandlords; i++) {
+        landlord = &(data->landlords.elems[i]);
+        landlord_init(landlord);
+        memcpy(landlord->id, landlords[i].id, MAX_PERSON_ID + 1);
+        landlord->tax = landlords[i].tax;
+        landlord->name = api_snapshotName(names, landlords[i].name);
+        if (landlords[i].numProperties > 0) {
+            landlord->properties.elems = (tProperty*) malloc(landlords[i].numProperties * sizeof(tProperty));
+            assert(landlord->properties.elems != NULL);
+            memcpy(landlord->properties.elems, properties, landlords[i].numProperties * sizeof(tProperty));
+            landlord->properties.count = landlords[i].numProperties;
+            landlord->properties.capacity = landlords[i].numProperties;
+        }
+        properties += landlords[i].numProperties;
+    }
+    // The indexes and the id, tax and name columns are built from the loaded elements
+    data->landlords.count = header.numLandlords;
+    landlords_reindex(&(data->landlords));
+    
+    // Rental incomes, pointing to the loaded landlords. They are added in bulk mode, as any other load
+    rentalIncomes_reserve(&(data->rentalIncomes), header.numRentalIncomes);
+    rentalIncomes_beginBulk(&(data->rentalIncomes));
+    for (i = 0; i < header.numRentalIncomes; i++) {
+        income.landlord = &(data->landlords.elems[incomes[i].landlord]);
+        income.year = incomes[i].year;
+        income.totalIncome = incomes[i].totalIncome;
+        rentalIncomes_add(&(data->rentalIncomes), income);
+    }
+    rentalIncomes_endBulk(&(data->rentalIncomes));
+    
+    free(payload);
+    
     return E_SUCCESS;
 }
 
+// Get the number of tenants and landlords whose id does not have the right control letter
+int api_invalidIdsCount(const tApiData* data) {
+    char ids[API_ID_BATCH_SIZE * PERSON_ID_LENGTH];
+    bool valid[API_ID_BATCH_SIZE];
+    const char* id;
+    int count = 0;
+    int numIds = 0;
+    int i;
+    
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    
+    // Gather the ids in fixed-width blocks, tenants first and then landlords. Shorter ids keep their 
+    // terminator in the block, so they are not valid
+    for (i = 0; i < data->tenants.count + data->landlords.count; i++) {
+        id = (i < data->tenants.count) ? data->tenants.elems[i].tenant_id : 
+            data->landlords.elems[i - data->tenants.count].id;
+        memcpy(ids + numIds * PERSON_ID_LENGTH, id, PERSON_ID_LENGTH);
+        numIds++;
+        if (numIds == API_ID_BATCH_SIZE) {
+            count += numIds - personId_validateBlock(ids, numIds, valid);
+            numIds = 0;
+        }
+    }
+    count += numIds - personId_validateBlock(ids, numIds, valid);
+    
+    return count;
+}
+
 // Initialize the data structure
 tApiError api_initData(tApiData* data) {            
     //////////////////////////////////
@@ -82,6 +767,11 @@ tApiError api_initData(tApiData* data) {
 
 // Add a tenant into the data if it does not exist
 tApiError api_addTenant(tApiData* data, tCSVEntry entry) {
+    return api_addTenant_ptr(data, &entry);
+}
+
+// Add a tenant into the data if it does not exist, taking the entry by pointer
+tApiError api_addTenant_ptr(tApiData* data, const tCSVEntry* entry) {
     //////////////////////////////////
     // Ex PR1 2c
     /////////////////////////////////
@@ -92,36 +782,38 @@ tApiError api_addTenant(tApiData* data, tCSVEntry entry) {
     assert(data != NULL);
 
     // Comprobar que el tipo es "TENANT"
-    if (strcmp(csv_getType(&entry), "TENANT") != 0) {
+    if (csv_getTypeId(entry) != CSV_TYPE_TENANT) {
         return E_INVALID_ENTRY_TYPE;
     }
 
     // Comprobar que el formato es correcto
-    if (csv_numFields(entry) != NUM_FIELDS_TENANT) {
+    if (csv_numFields_ptr(entry) != NUM_FIELDS_TENANT) {
         return E_INVALID_ENTRY_FORMAT;
     }
 
     // Inicializar el nuevo inquilino y analizar el CSV en tTenant
     tTenant tenant;
-    tenant_parse(&tenant, entry);
+    if (!tenant_parse_ptr(&tenant, entry)) {
+        tenant_free(&tenant);
+        return E_INVALID_ENTRY_FORMAT;
+    }
 
-    // Verificar si el inquilino ya existe
-    if (tenantData_find(data->tenants, tenant.tenant_id) >= 0) {
+    // Añadir el inquilino a data, que pasa a ser el propietario de su memoria
+    if (!tenantData_add_move(&data->tenants, &tenant)) {
         tenant_free(&tenant);  // Liberar memoria si el inquilino ya existe
         return E_TENANT_DUPLICATED;
     }
 
-    // Añadir el inquilino a data
-    tenantData_add(&data->tenants, tenant);
-
-    // Liberar cualquier recurso temporal si es necesario
-    tenant_free(&tenant);
-
     return E_SUCCESS;
 }
 
 // Add a landlord if it does not exist
 tApiError api_addLandlord(tApiData* data, tCSVEntry entry) {
+    return api_addLandlord_ptr(data, &entry);
+}
+
+// Add a landlord if it does not exist, taking the entry by pointer
+tApiError api_addLandlord_ptr(tApiData* data, const tCSVEntry* entry) {
     //////////////////////////////////
     // Ex PR1 2d
     /////////////////////////////////
@@ -129,27 +821,27 @@ tApiError api_addLandlord(tApiData* data, tCSVEntry entry) {
     /////////////////////////////////
     
     // Comprobar si el tipo de entrada es correcto
-    if (strcmp(csv_getType(&entry), "LANDLORD") != 0) {
+    if (csv_getTypeId(entry) != CSV_TYPE_LANDLORD) {
         return E_INVALID_ENTRY_TYPE;
     }
 
     // Comprobar si el formato de la entrada es correcto
-    if (csv_numFields(entry) != NUM_FIELDS_LANDLORD) {
+    if (csv_numFields_ptr(entry) != NUM_FIELDS_LANDLORD) {
         return E_INVALID_ENTRY_FORMAT;
     }
 
     // Parsear el propietario desde la entrada CSV
     tLandlord new_landlord;
-    landlord_parse(&new_landlord, entry);
+    if (!landlord_parse_ptr(&new_landlord, entry)) {
+        landlord_free(&new_landlord);
+        return E_INVALID_ENTRY_FORMAT;
+    }
 
-    // Verificar si el propietario ya existe
-    if (landlords_find(data->landlords, new_landlord.id) >= 0) {
+    // Añadir el nuevo propietario a la estructura de datos, que pasa a ser el propietario de su memoria
+    if (!landlords_add_move(&data->landlords, &new_landlord)) {
         landlord_free(&new_landlord); // Liberar memoria en caso de duplicado
         return E_LANDLORD_DUPLICATED;
     }
-    
-    // Añadir el nuevo propietario a la estructura de datos
-    landlords_add(&data->landlords, new_landlord);
 
     // Operación exitosa
     return E_SUCCESS;
@@ -157,6 +849,11 @@ tApiError api_addLandlord(tApiData* data, tCSVEntry entry) {
 
 // Add a property into the properties of an specific landlord
 tApiError api_addProperty(tApiData* data, tCSVEntry entry) {
+    return api_addProperty_ptr(data, &entry);
+}
+
+// Add a property into the properties of an specific landlord, taking the entry by pointer
+tApiError api_addProperty_ptr(tApiData* data, const tCSVEntry* entry) {
     //////////////////////////////////
     // Ex PR1 2e
     /////////////////////////////////
@@ -168,27 +865,28 @@ tApiError api_addProperty(tApiData* data, tCSVEntry entry) {
     int property_idx;
     
     // Verificación de tipo de entrada
-    if (strcmp(csv_getType(&entry), "PROPERTY") != 0) {
+    if (csv_getTypeId(entry) != CSV_TYPE_PROPERTY) {
         return E_INVALID_ENTRY_TYPE;
     }
     
     // Validación del formato (número de campos)
-    if (csv_numFields(entry) != 4) {
+    if (csv_numFields_ptr(entry) != 4) {
         return E_INVALID_ENTRY_FORMAT;
     }
 
     // Parse de los datos de la propiedad
-    property_parse(&new_property, entry);
+    if (!property_parse_ptr(&new_property, entry)) {
+        return E_INVALID_ENTRY_FORMAT;
+    }
 
     // Búsqueda del propietario correspondiente
-    landlord_idx = landlords_find(data->landlords, new_property.landlord_id);
+    landlord_idx = landlords_find_ptr(&(data->landlords), new_property.landlord_id);
     if (landlord_idx < 0) {
         return E_LANDLORD_NOT_FOUND;
     }
 
-    // Verificación si la propiedad ya existe
-    property_idx = properties_find(data->landlords.elems[landlord_idx].properties, new_property.cadastral_ref);
-    if (property_idx >= 0) {
+    // Verificación si la propiedad ya existe en cualquier propietario
+    if (landlords_find_property_ptr(&(data->landlords), new_property.cadastral_ref, &property_idx) >= 0) {
         return E_PROPERTY_DUPLICATED;
     }
 
@@ -200,6 +898,11 @@ tApiError api_addProperty(tApiData* data, tCSVEntry entry) {
 
 // Add a rental income into a list if the landlord already exists
 tApiError api_addRentalIncome(tApiData* data, tCSVEntry entry) {
+    return api_addRentalIncome_ptr(data, &entry);
+}
+
+// Add a rental income into a list if the landlord already exists, taking the entry by pointer
+tApiError api_addRentalIncome_ptr(tApiData* data, const tCSVEntry* entry) {
     //////////////////////////////////
     // Ex PR1 2f
     /////////////////////////////////
@@ -210,20 +913,20 @@ tApiError api_addRentalIncome(tApiData* data, tCSVEntry entry) {
     char landlord_id[MAX_PERSON_ID + 1];  // Almacenar temporalmente el ID del propietario
 
     // Verificar que el tipo de entrada es correcto
-    if (strcmp(csv_getType(&entry), "RENTAL_INCOME") != 0) {
+    if (csv_getTypeId(entry) != CSV_TYPE_RENTAL_INCOME) {
         return E_INVALID_ENTRY_TYPE;
     }
 
     // Verificar si el formato es correcto (esperamos 3 campos)
-    if (csv_numFields(entry) != 3) {
+    if (csv_numFields_ptr(entry) != 3) {
         return E_INVALID_ENTRY_FORMAT;
     }
 
     // Obtener el ID del propietario desde el CSV antes de parsear completamente los ingresos
-    csv_getAsString(entry, 2, landlord_id, MAX_PERSON_ID + 1);
+    csv_getAsString_ptr(entry, 2, landlord_id, MAX_PERSON_ID + 1);
 
     // Buscar al propietario correspondiente al ingreso
-    landlord_idx = landlords_find(data->landlords, landlord_id);
+    landlord_idx = landlords_find_ptr(&(data->landlords), landlord_id);
     if (landlord_idx < 0) {
         return E_LANDLORD_NOT_FOUND;
     }
@@ -232,7 +935,9 @@ tApiError api_addRentalIncome(tApiData* data, tCSVEntry entry) {
     new_income.landlord = &(data->landlords.elems[landlord_idx]);
 
     // Parsear los datos de ingresos fiscales
-    rentalIncome_parse(&new_income, entry);
+    if (!rentalIncome_parse_ptr(&new_income, entry)) {
+        return E_INVALID_ENTRY_FORMAT;
+    }
 
     // Agregar el ingreso a los datos de ingresos fiscales
     tApiError err = rentalIncomes_add(&data->rentalIncomes, new_income);
@@ -248,72 +953,27 @@ tRentalIncome* rentalIncomes_find(tRentalIncomeList list, int year, const char*
     //////////////////////////////////
     // Ex PR1 2g
     /////////////////////////////////
-    
+    return rentalIncomes_find_ptr(&list, year, document_id);
     /////////////////////////////////
-    
-    tRentalIncome new_income;
-    tRentalIncomeListNode* newNode = NULL;
-    tRentalIncomeListNode* pNode = NULL;
-    tRentalIncomeListNode* pPrev = NULL;
-    int landlord_idx;
-
-    // Comprobar si el tipo de entrada es correcto
-    if (strcmp(csv_getType(&entry), "RENTAL_INCOME") != 0) {
-        return E_INVALID_ENTRY_TYPE;
-    }
-
-    // Comprobar si el formato es correcto (esperamos 2 campos)
-    if (csv_numFields(entry) != 2) {
-        return E_INVALID_ENTRY_FORMAT;
-    }
-
-    // Parsear los datos de ingresos fiscales
-    rentalIncome_parse(&new_income, entry);
-
-    // Buscar al propietario correspondiente al ingreso
-    landlord_idx = landlords_find(data->landlords, new_income.landlord->id);
-    if (landlord_idx < 0) {
-        return E_LANDLORD_NOT_FOUND;
-    }
-
-    // Asignar el propietario encontrado al ingreso
-    new_income.landlord = &(data->landlords.elems[landlord_idx]);
+}
 
-    // Crear un nuevo nodo para el ingreso fiscal
-    newNode = (tRentalIncomeListNode*)malloc(sizeof(tRentalIncomeListNode));
-    assert(newNode != NULL);  // Verificar que la asignación fue exitosa
-    rentalIncome_cpy(&(newNode->elem), new_income);
-    newNode->next = NULL;
-
-    // Insertar en la lista de ingresos en orden por año
-    if (data->rentalIncomes.count == 0) {
-        // Si la lista está vacía, añadir como primer elemento
-        data->rentalIncomes.first = newNode;
-    } else {
-        pNode = data->rentalIncomes.first;
-        while (pNode != NULL && pNode->elem.year < new_income.year) {
-            pPrev = pNode;
-            pNode = pNode->next;
-        }
-        
-        if (pPrev == NULL) {
-            // Insertar como primer elemento si es el más antiguo
-            newNode->next = data->rentalIncomes.first;
-            data->rentalIncomes.first = newNode;
-        } else {
-            // Insertar después de pPrev si es un elemento intermedio o final
-            pPrev->next = newNode;
-            newNode->next = pNode;
-        }
-    }
+// Find a rental income by year and landlord document id, taking the list by pointer
+tRentalIncome* rentalIncomes_find_ptr(const tRentalIncomeList* list, int year, const char* document_id) {
+    int pos;
     
-    // Incrementar el contador de ingresos en la lista
-    data->rentalIncomes.count++;
-    return E_SUCCESS;
+    // Binary search by year and landlord id
+    pos = rentalIncomes_position_ptr(list, year, document_id);
+    
+    return (pos >= 0) ? rentalIncomes_get_ptr(list, pos) : NULL;
 }
 
 // Get the number of tenants registered on the application
 int api_tenantCount(tApiData data) {
+    return api_tenantCount_ptr(&data);
+}
+
+// Get the number of tenants registered on the application, taking the data by pointer
+int api_tenantCount_ptr(const tApiData* data) {
     //////////////////////////////////
     // Ex PR1 2h
     /////////////////////////////////
@@ -325,6 +985,11 @@ int api_tenantCount(tApiData data) {
 
 // Get the number of landlords registered on the application
 int api_landlordsCount(tApiData data) {
+    return api_landlordsCount_ptr(&data);
+}
+
+// Get the number of landlords registered on the application, taking the data by pointer
+int api_landlordsCount_ptr(const tApiData* data) {
     //////////////////////////////////
     // Ex PR1 2h
     /////////////////////////////////
@@ -335,6 +1000,11 @@ int api_landlordsCount(tApiData data) {
 
 // Get the number of properties in all landlords registered on the application
 int api_propertiesCount(tApiData data) {
+    return api_propertiesCount_ptr(&data);
+}
+
+// Get the number of properties in all landlords registered on the application, taking the data by pointer
+int api_propertiesCount_ptr(const tApiData* data) {
     //////////////////////////////////
     // Ex PR1 2h
     /////////////////////////////////
@@ -345,6 +1015,11 @@ int api_propertiesCount(tApiData data) {
 
 // Get the number of rental incomes registered
 int api_rentalIncomesCount(tApiData data) {
+    return api_rentalIncomesCount_ptr(&data);
+}
+
+// Get the number of rental incomes registered, taking the data by pointer
+int api_rentalIncomesCount_ptr(const tApiData* data) {
     //////////////////////////////////
     // Ex PR1 2h
     /////////////////////////////////
@@ -365,18 +1040,47 @@ tApiError api_freeData(tApiData* data) {
 }
 
 
+// Functions that add each known type of entry
+static tApiError (* const api_addEntryFunctions[CSV_NUM_TYPES])(tApiData*, const tCSVEntry*) = {
+    [CSV_TYPE_UNKNOWN] = NULL,
+    [CSV_TYPE_TENANT] = api_addTenant_ptr,
+    [CSV_TYPE_LANDLORD] = api_addLandlord_ptr,
+    [CSV_TYPE_PROPERTY] = api_addProperty_ptr,
+    [CSV_TYPE_RENTAL_INCOME] = api_addRentalIncome_ptr
+};
+
 // Add a new entry
 tApiError api_addDataEntry(tApiData* data, tCSVEntry entry) { 
+    return api_addDataEntry_ptr(data, &entry);
+}
+
+// Add a new entry, taking it by pointer
+tApiError api_addDataEntry_ptr(tApiData* data, const tCSVEntry* entry) { 
     //////////////////////////////////
     // Ex PR1 2j
     /////////////////////////////////
+    tApiError (*addEntry)(tApiData*, const tCSVEntry*);
+    
+    assert(data != NULL);
+    assert(entry != NULL);
     
+    // Seleccionar la función según el tipo de la entrada
+    addEntry = api_addEntryFunctions[csv_getTypeId(entry)];
+    if (addEntry == NULL) {
+        return E_INVALID_ENTRY_TYPE;
+    }
+    
+    return addEntry(data, entry);
     /////////////////////////////////
-    return E_NOT_IMPLEMENTED;
 }
 
 // Get landlord data
 tApiError api_getLandlord(tApiData data, const char *id, tCSVEntry *entry) {
+    return api_getLandlord_ptr(&data, id, entry);
+}
+
+// Get landlord data, taking the data by pointer
+tApiError api_getLandlord_ptr(const tApiData* data, const char *id, tCSVEntry *entry) {
     //////////////////////////////////
     // Ex PR1 3a
     /////////////////////////////////
@@ -387,6 +1091,11 @@ tApiError api_getLandlord(tApiData data, const char *id, tCSVEntry *entry) {
 
 // Get the rental income by year of a landlord
 tApiError api_getRentalIncome(tApiData data, int year, const char* id, tCSVEntry *entry) {
+    return api_getRentalIncome_ptr(&data, year, id, entry);
+}
+
+// Get the rental income by year of a landlord, taking the data by pointer
+tApiError api_getRentalIncome_ptr(const tApiData* data, int year, const char* id, tCSVEntry *entry) {
     //////////////////////////////////
     // Ex PR1 3b
     /////////////////////////////////
@@ -397,6 +1106,11 @@ tApiError api_getRentalIncome(tApiData data, int year, const char* id, tCSVEntry
 
 // Get registered properties
 tApiError api_getProperties(tApiData data, tCSVData *properties) {
+    return api_getProperties_ptr(&data, properties);
+}
+
+// Get registered properties, taking the data by pointer
+tApiError api_getProperties_ptr(const tApiData* data, tCSVData *properties) {
     //////////////////////////////////
     // Ex PR1 3c
     /////////////////////////////////
@@ -407,6 +1121,11 @@ tApiError api_getProperties(tApiData data, tCSVData *properties) {
 
 // Get registered rental incomes
 tApiError api_getRentalIncomes(tApiData data, tCSVData *rentalIncomes) {
+    return api_getRentalIncomes_ptr(&data, rentalIncomes);
+}
+
+// Get registered rental incomes, taking the data by pointer
+tApiError api_getRentalIncomes_ptr(const tApiData* data, tCSVData *rentalIncomes) {
     //////////////////////////////////
     // Ex PR1 3d
     /////////////////////////////////
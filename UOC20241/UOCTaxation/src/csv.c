@@ -3,73 +3,308 @@
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <stdint.h>
+#include <limits.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CSV_USE_SIMD
+#endif
+#include <fcntl.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define CSV_USE_MMAP
+#else
+#include <io.h>
+#endif
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+// Size of the blocks scanned at once by the tokenizer
+#define CSV_SCAN_BLOCK 64
+
+// Maximum length of a formatted number, and of any double written with up to 9 decimals
+#define CSV_NUMBER_LENGTH 32
+#define CSV_LARGE_NUMBER_LENGTH 512
+
+// Number of separators that can be found on a line without using the heap
+#define CSV_SCAN_FIELDS 32
+
+// Initial number of entries of a tCSVData, doubled every time it is full
+#define CSV_INITIAL_ENTRIES 16
+
+// Size of the chunks used by a tCSVData in arena mode
+#define CSV_CHUNK_SIZE 65536
+
+// Find the delimiters of a block, one bit per byte for ';' and another one for '\n'
+typedef void (*tCSVScanBlock)(const char* block, uint64_t* separators, uint64_t* newlines);
+
+// Names of the known types of entries
+static const char* const csv_typeNames[CSV_NUM_TYPES] = {
+    NULL, "TENANT", "LANDLORD", "PROPERTY", "RENTAL_INCOME"
+};
+
+// Position of the lowest bit set in a mask
+static inline int csv_lowestBit(uint64_t mask) {
+#ifdef __GNUC__
+    return __builtin_ctzll(mask);
+#else
+    int i = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+// Find the delimiters of a block one byte at a time
+static void csv_scanBlockScalar(const char* block, uint64_t* separators, uint64_t* newlines) {
+    int i;
+    
+    *separators = 0;
+    *newlines = 0;
+    for (i = 0; i < CSV_SCAN_BLOCK; i++) {
+        *separators |= (uint64_t) (block[i] == ';') << i;
+        *newlines |= (uint64_t) (block[i] == '\n') << i;
+    }
+}
+
+#ifdef CSV_USE_SIMD
+// Find the delimiters of a block 16 bytes at a time
+__attribute__((target("sse2")))
+static void csv_scanBlockSSE2(const char* block, uint64_t* separators, uint64_t* newlines) {
+    const __m128i sep = _mm_set1_epi8(';');
+    const __m128i nl = _mm_set1_epi8('\n');
+    __m128i chunk;
+    int i;
+    
+    *separators = 0;
+    *newlines = 0;
+    for (i = 0; i < CSV_SCAN_BLOCK; i += 16) {
+        chunk = _mm_loadu_si128((const __m128i*) (block + i));
+        *separators |= (uint64_t) (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, sep)) << i;
+        *newlines |= (uint64_t) (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, nl)) << i;
+    }
+}
+
+// Find the delimiters of a block 32 bytes at a time
+__attribute__((target("avx2")))
+static void csv_scanBlockAVX2(const char* block, uint64_t* separators, uint64_t* newlines) {
+    const __m256i sep = _mm256_set1_epi8(';');
+    const __m256i nl = _mm256_set1_epi8('\n');
+    __m256i lo, hi;
+    
+    lo = _mm256_loadu_si256((const __m256i*) block);
+    hi = _mm256_loadu_si256((const __m256i*) (block + 32));
+    *separators = (uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, sep)) |
+                  (uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, sep)) << 32;
+    *newlines = (uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, nl)) |
+                (uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, nl)) << 32;
+}
+#endif
+
+// Select the best block scanner for this CPU on the first call
+static void csv_scanBlockInit(const char* block, uint64_t* separators, uint64_t* newlines);
+
+// Block scanner in use. Several threads may select it at the same time, so it is accessed atomically
+static tCSVScanBlock csv_scanBlock = csv_scanBlockInit;
+#ifdef __GNUC__
+#define CSV_GET_SCANNER() __atomic_load_n(&csv_scanBlock, __ATOMIC_RELAXED)
+#define CSV_SET_SCANNER(scanner) __atomic_store_n(&csv_scanBlock, (scanner), __ATOMIC_RELAXED)
+#else
+#define CSV_GET_SCANNER() csv_scanBlock
+#define CSV_SET_SCANNER(scanner) (csv_scanBlock = (scanner))
+#endif
+
+// Select the best block scanner for this CPU on the first call
+static void csv_scanBlockInit(const char* block, uint64_t* separators, uint64_t* newlines) {
+    tCSVScanBlock scanner = csv_scanBlockScalar;
+    
+#ifdef CSV_USE_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        scanner = csv_scanBlockAVX2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        scanner = csv_scanBlockSSE2;
+    }
+#endif
+    CSV_SET_SCANNER(scanner);
+    scanner(block, separators, newlines);
+}
+
+// Scan a line up to the first '\n' or the given length. The offsets of the first maxPositions 
+// separators are stored in positions and their total number in count. Returns the line length
+static int csv_scanLine(const char* input, int length, int* positions, int maxPositions, int* count) {
+    char tail[CSV_SCAN_BLOCK];
+    const char* block;
+    uint64_t separators, newlines;
+    tCSVScanBlock scanBlock = CSV_GET_SCANNER();
+    int offset, end;
+    int n = 0;
+    
+    for (offset = 0; offset < length; offset += CSV_SCAN_BLOCK) {
+        // The last block is padded so the scanners never read outside the input
+        if (length - offset >= CSV_SCAN_BLOCK) {
+            block = input + offset;
+        } else {
+            memset(tail, 0, CSV_SCAN_BLOCK);
+            memcpy(tail, input + offset, length - offset);
+            block = tail;
+        }
+        scanBlock(block, &separators, &newlines);
+        
+        // Ignore the separators after the end of the line
+        end = CSV_SCAN_BLOCK;
+        if (newlines != 0) {
+            end = csv_lowestBit(newlines);
+            separators &= ((uint64_t) 1 << end) - 1;
+        }
+        
+        // Emit the separators found in the block
+        while (separators != 0) {
+            if (n < maxPositions) {
+                positions[n] = offset + csv_lowestBit(separators);
+            }
+            n++;
+            separators &= separators - 1;
+        }
+        
+        if (newlines != 0) {
+            *count = n;
+            return offset + end;
+        }
+    }
+    
+    *count = n;
+    return length;
+}
 
 // Initialize the tCSVData structure
 void csv_init(tCSVData* data) {
     data->count = 0;
+    data->capacity = 0;
     data->isValid = false;
     data->entries = NULL;
+    data->useArena = false;
+    data->chunks = NULL;
+}
+
+// Initialize the tCSVData structure in arena mode
+void csv_initArena(tCSVData* data) {
+    csv_init(data);
+    data->useArena = true;
+}
+
+// Take memory for an entry from the chunks of a tCSVData
+static void* csv_arenaAlloc(tCSVData* data, int size) {
+    tCSVChunk* chunk = data->chunks;
+    void* block;
+    int chunkSize;
+    
+    // Keep the blocks aligned for the field views
+    size = (size + 7) & ~7;
+    
+    if (chunk == NULL || chunk->size - chunk->used < size) {
+        chunkSize = (size > CSV_CHUNK_SIZE) ? size : CSV_CHUNK_SIZE;
+        chunk = (tCSVChunk*) malloc(sizeof(tCSVChunk) + chunkSize);
+        assert(chunk != NULL);
+        chunk->size = chunkSize;
+        chunk->used = 0;
+        chunk->next = data->chunks;
+        data->chunks = chunk;
+    }
+    
+    // Data of the chunk starts right after its header
+    block = ((char*) (chunk + 1)) + chunk->used;
+    chunk->used += size;
+    
+    return block;
 }
 
 // Initialize the tCSVEntry structure
 void csv_initEntry(tCSVEntry* entry) {
     entry->numFields = 0;    
+    entry->typeId = CSV_TYPE_UNKNOWN;
     entry->fields = NULL;
     entry->type = NULL;
+    entry->line = NULL;
+    entry->views = NULL;
+    entry->capacity = 0;
+}
+
+// Get the address of a field, either from the copied fields or from the line slices
+static const char* csv_fieldPtr(const tCSVEntry* entry, int position) {
+    assert(position >= 0 && position < entry->numFields);
+    if (entry->views != NULL) {
+        return entry->line + entry->views[position].offset;
+    }
+    return entry->fields[position];
+}
+
+// Parse a CSV line as a view entry, taking its memory from the arena of a tCSVData if given
+static int csv_parseEntryInto(tCSVEntry* entry, const char* input, int length, const char* type, tCSVData* arena);
+
+// Add a new entry to the CSV Data from a line of given length. Returns the length of the line
+static int csv_addEntryView(tCSVData* data, const char* line, int length, const char* type) {
+    tCSVEntry* entry;
+    
+    // Grow the entries geometrically
+    if (data->count == data->capacity) {
+        data->capacity = (data->capacity == 0) ? CSV_INITIAL_ENTRIES : data->capacity * 2;
+        data->entries = (tCSVEntry*) realloc(data->entries, data->capacity * sizeof(tCSVEntry));
+        assert(data->entries != NULL);
+    }
+    entry = &(data->entries[data->count]);
+    data->count++;
+    csv_initEntry(entry);
+    
+    return csv_parseEntryInto(entry, line, length, type, data->useArena ? data : NULL);
 }
 
 // Add a new entry to the CSV Data
 void csv_addStrEntry(tCSVData* data, const char* entry, const char* type) {
     assert( data != NULL );
     assert( entry != NULL );
-    data->count++;
-    if (data->count == 1) {
-        data->entries = (tCSVEntry*) malloc(sizeof(tCSVEntry));
-    } else {
-        data->entries = (tCSVEntry*) realloc(data->entries, data->count * sizeof(tCSVEntry));
-    }
-    csv_initEntry(&(data->entries[data->count-1]));
-    csv_parseEntry(&(data->entries[data->count-1]), entry, type);
+    csv_addEntryView(data, entry, strlen(entry), type);
 }
 
 // Parse the contents of a CSV file
 void csv_parse(tCSVData* data, const char* input, const char* type) {
-    const char *pStart, *pEnd;
-    char *line;
-    int len;
+    const char *pStart, *pLast;
     
     assert(data->count == 0);
     assert(data->entries == NULL);
     assert(!data->isValid);
     
     pStart = input;
-    pEnd = strchr(pStart, '\n');    
-    while(pEnd != NULL && pEnd != pStart) {
-        len = pEnd - pStart + 1;
-        line = (char*) malloc(len * sizeof(char));
-        memset(line, 0, len * sizeof(char));
-        strncpy(line, pStart, pEnd - pStart);
-        // Add the new entry line
-        csv_addStrEntry(data, line, type);
-        free(line);
-        pStart = pEnd + 1;
-        pEnd = strchr(pStart, '\n');
-    }
-    pEnd = strchr(pStart, '\0');
-    if (pEnd != NULL && pEnd != pStart) {
-        len = pEnd - pStart + 1;
-        line = (char*) malloc(len * sizeof(char));
-        memset(line, 0, len * sizeof(char));
-        strncpy(line, pStart, pEnd - pStart);
-        data->count++;
-        if (data->count == 1) {
-            data->entries = (tCSVEntry*) malloc(sizeof(tCSVEntry));
+    pLast = input + strlen(input);
+    // Add the entries until the end of the input or an empty line
+    while (pStart < pLast && *pStart != '\n') {
+        pStart += csv_addEntryView(data, pStart, pLast - pStart, type) + 1;
+    }
+    data->isValid = true;
+}
+
+// Parse all the lines of a buffer of given length, skipping empty lines
+void csv_parseBuffer(tCSVData* data, const char* input, size_t length, const char* type) {
+    const char *pStart, *pLast;
+    
+    assert(data != NULL);
+    assert(input != NULL || length == 0);
+    
+    pStart = input;
+    pLast = input + length;
+    while (pStart < pLast) {
+        if (*pStart == '\n') {
+            pStart++;
+        } else if (*pStart == '\r' && (pStart + 1 == pLast || pStart[1] == '\n')) {
+            pStart += 2;
         } else {
-            data->entries = (tCSVEntry*) realloc(data->entries, data->count * sizeof(tCSVEntry));
+            pStart += csv_addEntryView(data, pStart, (pLast - pStart > INT_MAX) ? INT_MAX : pLast - pStart, type) + 1;
         }
-        csv_initEntry(&(data->entries[data->count-1]));
-        csv_parseEntry(&(data->entries[data->count-1]), line, type);
-        free(line);
     }
     data->isValid = true;
 }
@@ -100,65 +335,115 @@ void csv_printEntry(tCSVEntry entry) {
     }
 }
 
-// Parse the contents of a CSV line
+// Parse the contents of a CSV line. It is parsed as a view entry, so the line is scanned by blocks and 
+// copied with a single allocation, and splits in the same fields as the lines of a file
 void csv_parseEntry(tCSVEntry* entry, const char* input, const char* type) {
-    const char *pStart, *pEnd;    
-    int len;
-    bool readType = true;
-    
     assert(entry->numFields == 0);
     assert(entry->fields == NULL);
     
+    csv_parseEntryInto(entry, input, strlen(input), type, NULL);
+}
+
+// Parse a CSV line of given length as a view entry
+int csv_parseEntryView(tCSVEntry* entry, const char* input, int length, const char* type) {
+    return csv_parseEntryInto(entry, input, length, type, NULL);
+}
+
+// Parse a CSV line as a view entry, taking its memory from the arena of a tCSVData if given
+static int csv_parseEntryInto(tCSVEntry* entry, const char* input, int length, const char* type, tCSVData* arena) {
+    int stackPositions[CSV_SCAN_FIELDS];
+    int* positions = stackPositions;
+    int numSeparators, lineLength, len, start, i;
+    int typeLen, viewsSize, required;
+    
+    assert(entry != NULL);
+    assert(input != NULL);
+    assert(length >= 0);
+    assert(entry->fields == NULL);
+    assert(arena == NULL || entry->views == NULL);
+    
+    // Find the end of the line and its separators in a single pass
+    lineLength = csv_scanLine(input, length, positions, CSV_SCAN_FIELDS, &numSeparators);
+    if (numSeparators > CSV_SCAN_FIELDS) {
+        positions = (int*) malloc(numSeparators * sizeof(int));
+        assert(positions != NULL);
+        csv_scanLine(input, lineLength, positions, numSeparators, &numSeparators);
+    }
+    
+    // Remove carriage return character
+    len = lineLength;
+    if (len > 0 && input[len - 1] == '\r') {
+        len--;
+    }
+    
+    // Size the single block holding the views and the copy of the line
+    // Known types are not copied
+    typeLen = 0;
+    entry->typeId = CSV_TYPE_UNKNOWN;
+    if (type != NULL) {
+        typeLen = strlen(type);
+        entry->typeId = csv_internType(type, typeLen);
+        typeLen = (entry->typeId == CSV_TYPE_UNKNOWN) ? typeLen + 1 : 0;
+    }
+    viewsSize = (numSeparators + 1) * sizeof(tCSVField);
+    required = viewsSize + len + 1 + typeLen;
+    
+    // Take the memory from the arena, or reuse the memory of a previous line when it is big enough
+    if (arena != NULL) {
+        entry->views = (tCSVField*) csv_arenaAlloc(arena, required);
+    } else if (required > entry->capacity) {
+        if (entry->capacity > 0) {
+            free(entry->views);
+        }
+        entry->views = (tCSVField*) malloc(required);
+        assert(entry->views != NULL);
+        entry->capacity = required;
+    }
+    entry->line = ((char*) entry->views) + viewsSize;
+    memcpy(entry->line, input, len);
+    entry->line[len] = '\0';
+    entry->numFields = 0;
+    
     // If the type of the entry is not provided, use the first field
-    if(type != NULL) {
-        len = strlen(type) + 1;
-        entry->type = (char*) malloc(len * sizeof(char));
-        memset(entry->type, 0, len * sizeof(char));
-        strncpy(entry->type, type, len);
-        readType = false;
-    }        
-    pStart = input;
-    pEnd = strchr(pStart, ';');    
-    while(pEnd != NULL && pEnd != pStart) {        
-        // Get the length of the field
-        len = pEnd - pStart + 1;
-        
-        if(readType) {
-            entry->type = (char*) malloc(len * sizeof(char));
-            memset(entry->type, 0, len * sizeof(char));
-            strncpy(entry->type, pStart, pEnd - pStart);
-            readType = false;
+    if (type == NULL) {
+        entry->type = NULL;
+    } else if (entry->typeId != CSV_TYPE_UNKNOWN) {
+        entry->type = (char*) csv_typeNames[entry->typeId];
+    } else {
+        entry->type = entry->line + len + 1;
+        memcpy(entry->type, type, typeLen);
+    }
+    
+    // Terminate every field in place, so slices are also valid strings
+    start = 0;
+    for (i = 0; i < numSeparators; i++) {
+        entry->line[positions[i]] = '\0';
+        if (entry->type == NULL) {
+            entry->type = entry->line + start;
+            entry->typeId = csv_internType(entry->type, positions[i] - start);
         } else {
+            entry->views[entry->numFields].offset = start;
+            entry->views[entry->numFields].length = positions[i] - start;
             entry->numFields++;
-            if (entry->numFields == 1) {
-                entry->fields = (char**) malloc(sizeof(char*));
-            } else {
-                entry->fields = (char**) realloc(entry->fields, entry->numFields * sizeof(char*));
-            }                
-            entry->fields[entry->numFields - 1] = (char*) malloc(len * sizeof(char));
-            memset(entry->fields[entry->numFields - 1], 0, len * sizeof(char));
-            strncpy(entry->fields[entry->numFields - 1], pStart, pEnd - pStart);
         }
-        
-        pStart = pEnd + 1;
-        pEnd = strchr(pStart, ';');
+        start = positions[i] + 1;
     }
-    pEnd = strchr(pStart, '\0');
-    if (pEnd != NULL && pEnd != pStart) {
-        
-        assert(!readType);
-        
-        entry->numFields++;
-        if (entry->numFields == 1) {
-            entry->fields = (char**) malloc(sizeof(char*));
+    if (start < len) {
+        if (entry->type == NULL) {
+            entry->type = entry->line + start;
+            entry->typeId = csv_internType(entry->type, len - start);
         } else {
-            entry->fields = (char**) realloc(entry->fields, entry->numFields * sizeof(char*));
-        }        
-        len = pEnd - pStart + 1;
-        entry->fields[entry->numFields - 1] = (char*) malloc(len * sizeof(char));
-        memset(entry->fields[entry->numFields - 1], 0, len * sizeof(char));
-        strncpy(entry->fields[entry->numFields - 1], pStart, pEnd - pStart);
+            entry->views[entry->numFields].offset = start;
+            entry->views[entry->numFields].length = len - start;
+            entry->numFields++;
+        }
     }
+    
+    if (positions != stackPositions) {
+        free(positions);
+    }
+    
+    return lineLength;
 }
 
 // Get the number of entries
@@ -168,19 +453,43 @@ bool csv_isValid(tCSVData data) {
 
 // Remove all data from structure
 void csv_free(tCSVData* data) {
+    tCSVChunk *chunk, *next;
+    bool useArena;
     int i;
     
-    for (i = 0; i < data->count; i++) {
-        csv_freeEntry(&(data->entries[i]));
+    // In arena mode the entries do not own their memory
+    if (data->useArena) {
+        chunk = data->chunks;
+        while (chunk != NULL) {
+            next = chunk->next;
+            free(chunk);
+            chunk = next;
+        }
+    } else {
+        for (i = 0; i < data->count; i++) {
+            csv_freeEntry(&(data->entries[i]));
+        }
     }
     free(data->entries);
+    
+    // Keep the allocation mode
+    useArena = data->useArena;
     csv_init(data);
+    data->useArena = useArena;
 }
 
 // Remove all data from structure
 void csv_freeEntry(tCSVEntry* entry) {
     int i;
     
+    // In view mode the type and the fields live in a single block
+    if(entry->views != NULL) {
+        if (entry->capacity > 0) {
+            free(entry->views);
+        }
+        csv_initEntry(entry);
+        return;
+    }
     if(entry->fields != NULL) {
         for(i = 0; i < entry->numFields; i++) {
             free(entry->fields[i]);
@@ -189,7 +498,7 @@ void csv_freeEntry(tCSVEntry* entry) {
         
         free(entry->fields);
     }
-    if(entry->type != NULL) {
+    if(entry->type != NULL && entry->typeId == CSV_TYPE_UNKNOWN) {
         free(entry->type);
     }
     csv_initEntry(entry);
@@ -201,10 +510,42 @@ int csv_numEntries(tCSVData data) {
 }
 
 // Get the type of information contained in the entry
-const char* csv_getType(tCSVEntry* entry) {
+const char* csv_getType(const tCSVEntry* entry) {
     return (const char*)entry->type;
 }
 
+// Get the type of the entry as one of the known types
+tCSVEntryType csv_getTypeId(const tCSVEntry* entry) {
+    return entry->typeId;
+}
+
+// Get the type of entry with the given name, CSV_TYPE_UNKNOWN if it is not one of the known types
+tCSVEntryType csv_internType(const char* name, int length) {
+    tCSVEntryType type = CSV_TYPE_UNKNOWN;
+    
+    // The length and the first character select the only candidate
+    switch (length) {
+        case 6:
+            type = (name[0] == 'T') ? CSV_TYPE_TENANT : CSV_TYPE_UNKNOWN;
+            break;
+        case 8:
+            if (name[0] == 'L') {
+                type = CSV_TYPE_LANDLORD;
+            } else if (name[0] == 'P') {
+                type = CSV_TYPE_PROPERTY;
+            }
+            break;
+        case 13:
+            type = (name[0] == 'R') ? CSV_TYPE_RENTAL_INCOME : CSV_TYPE_UNKNOWN;
+            break;
+    }
+    if (type != CSV_TYPE_UNKNOWN && memcmp(name, csv_typeNames[type], length) != 0) {
+        type = CSV_TYPE_UNKNOWN;
+    }
+    
+    return type;
+}
+
 // Get an entry from the CSV data
 tCSVEntry* csv_getEntry(tCSVData data, int position) {
     return &(data.entries[position]);
@@ -212,23 +553,650 @@ tCSVEntry* csv_getEntry(tCSVData data, int position) {
 
 // Get the number of fields for a given entry
 int csv_numFields(tCSVEntry entry) {
-    return entry.numFields;
+    return csv_numFields_ptr(&entry);
+}
+
+// Get the number of fields for a given entry
+int csv_numFields_ptr(const tCSVEntry* entry) {
+    return entry->numFields;
+}
+
+// Get the length of a field from the given entry
+int csv_getFieldLength(tCSVEntry entry, int position) {
+    return csv_getFieldLength_ptr(&entry, position);
+}
+
+// Get the length of a field from the given entry
+int csv_getFieldLength_ptr(const tCSVEntry* entry, int position) {
+    if (entry->views != NULL) {
+        assert(position >= 0 && position < entry->numFields);
+        return entry->views[position].length;
+    }
+    return strlen(csv_fieldPtr(entry, position));
+}
+
+// Check if any field of the entry is empty
+bool csv_hasEmptyField(const tCSVEntry* entry) {
+    int i;
+    
+    assert(entry != NULL);
+    
+    for (i = 0; i < entry->numFields; i++) {
+        if (csv_getFieldLength_ptr(entry, i) == 0) {
+            return true;
+        }
+    }
+    
+    return false;
 }
 
 // Get a field from the given entry as integer
 int csv_getAsInteger(tCSVEntry entry, int position) {
-    return atoi(entry.fields[position]);
+    return csv_getAsInteger_ptr(&entry, position);
+}
+
+// Get a field from the given entry as integer
+int csv_getAsInteger_ptr(const tCSVEntry* entry, int position) {
+    int value;
+    
+    // Fields that are not valid integers are 0, as csv_parseInteger leaves them
+    csv_tryGetAsInteger_ptr(entry, position, &value);
+    
+    return value;
 }
 
 // Get a field from the given entry as string
 void csv_getAsString(tCSVEntry entry, int position, char* buffer, int length) {
-    memset(buffer, 0, length);
-    strncpy(buffer, entry.fields[position], length - 1);
+    csv_getAsString_ptr(&entry, position, buffer, length);
+}
+
+// Get a field from the given entry as string
+void csv_getAsString_ptr(const tCSVEntry* entry, int position, char* buffer, int length) {
+    int len;
+    
+    if (entry->views != NULL) {
+        len = entry->views[position].length;
+        if (len > length - 1) {
+            len = length - 1;
+        }
+        memcpy(buffer, csv_fieldPtr(entry, position), len);
+        memset(buffer + len, 0, length - len);
+    } else {
+        memset(buffer, 0, length);
+        strncpy(buffer, entry->fields[position], length - 1);
+    }
 }
 
 // Get a field from the given entry as integer
 float csv_getAsReal(tCSVEntry entry, int position) {
-    return atof(entry.fields[position]);
+    return csv_getAsReal_ptr(&entry, position);
+}
+
+// Get a field from the given entry as real
+float csv_getAsReal_ptr(const tCSVEntry* entry, int position) {
+    float value;
+    
+    // Fields that are not valid decimal numbers are 0, as csv_parseReal leaves them
+    csv_tryGetAsReal_ptr(entry, position, &value);
+    
+    return value;
+}
+
+// Get a field from the given entry as integer. Returns false if the field is not a valid integer
+bool csv_tryGetAsInteger(tCSVEntry entry, int position, int* value) {
+    return csv_tryGetAsInteger_ptr(&entry, position, value);
+}
+
+// Get a field from the given entry as integer. Returns false if the field is not a valid integer
+bool csv_tryGetAsInteger_ptr(const tCSVEntry* entry, int position, int* value) {
+    return csv_parseInteger(csv_fieldPtr(entry, position), csv_getFieldLength_ptr(entry, position), value);
+}
+
+// Get a field from the given entry as real. Returns false if the field is not a valid decimal number
+bool csv_tryGetAsReal(tCSVEntry entry, int position, float* value) {
+    return csv_tryGetAsReal_ptr(&entry, position, value);
+}
+
+// Get a field from the given entry as real. Returns false if the field is not a valid decimal number
+bool csv_tryGetAsReal_ptr(const tCSVEntry* entry, int position, float* value) {
+    double real;
+    
+    bool valid;
+    
+    valid = csv_parseReal(csv_fieldPtr(entry, position), csv_getFieldLength_ptr(entry, position), &real);
+    *value = (float) real;
+    
+    return valid;
+}
+
+// Get a decimal amount from the given entry as integer cents. Returns false if the field is not a valid amount
+bool csv_tryGetAsCents(tCSVEntry entry, int position, long long* cents) {
+    return csv_tryGetAsCents_ptr(&entry, position, cents);
+}
+
+// Get a decimal amount from the given entry as integer cents. Returns false if the field is not a valid amount
+bool csv_tryGetAsCents_ptr(const tCSVEntry* entry, int position, long long* cents) {
+    return csv_parseCents(csv_fieldPtr(entry, position), csv_getFieldLength_ptr(entry, position), cents);
+}
+
+// Parse an integer "[+-]digits" of given length, independent of the locale
+bool csv_parseInteger(const char* text, int length, int* value) {
+    long long result = 0;
+    bool negative = false;
+    int i = 0;
+    
+    assert(text != NULL);
+    assert(value != NULL);
+    
+    // Invalid numbers are 0
+    *value = 0;
+    if (length > 0 && (text[0] == '-' || text[0] == '+')) {
+        negative = (text[0] == '-');
+        i++;
+    }
+    // At least one digit, and not more than an int can hold
+    if (i == length || length - i > 10) {
+        return false;
+    }
+    for (; i < length; i++) {
+        if ((unsigned char) (text[i] - '0') > 9) {
+            return false;
+        }
+        result = result * 10 + (text[i] - '0');
+    }
+    if (negative) {
+        result = -result;
+    }
+    if (result < INT_MIN || result > INT_MAX) {
+        return false;
+    }
+    *value = (int) result;
+    
+    return true;
+}
+
+// Parse the digits of a decimal number into an integer mantissa and the number of decimals
+static bool csv_parseDecimal(const char* text, int length, long long* mantissa, int* decimals, bool* negative, int maxDecimals, int* next) {
+    long long result = 0;
+    int digits = 0;
+    int i = 0;
+    bool point = false;
+    
+    *negative = false;
+    *decimals = 0;
+    if (length > 0 && (text[0] == '-' || text[0] == '+')) {
+        *negative = (text[0] == '-');
+        i++;
+    }
+    for (; i < length; i++) {
+        if (text[i] == '.' && !point) {
+            point = true;
+        } else if ((unsigned char) (text[i] - '0') <= 9) {
+            // Stop at the requested precision, the caller looks at the remaining digits
+            if (point && *decimals == maxDecimals) {
+                break;
+            }
+            // Up to 18 digits fit in the mantissa
+            if (++digits > 18) {
+                return false;
+            }
+            result = result * 10 + (text[i] - '0');
+            if (point) {
+                (*decimals)++;
+            }
+        } else {
+            return false;
+        }
+    }
+    *next = i;
+    *mantissa = result;
+    
+    return digits > 0;
+}
+
+// Parse a decimal number "[+-]digits[.digits]" of given length, independent of the locale
+bool csv_parseReal(const char* text, int length, double* value) {
+    static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 
+                                    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+    long long mantissa;
+    int decimals, next;
+    bool negative;
+    
+    assert(text != NULL);
+    assert(value != NULL);
+    
+    // Invalid numbers are 0
+    *value = 0;
+    if (!csv_parseDecimal(text, length, &mantissa, &decimals, &negative, 18, &next) || next != length) {
+        return false;
+    }
+    // A single division keeps the result correctly rounded for the usual amounts
+    *value = (double) mantissa / powers[decimals];
+    if (negative) {
+        *value = -*value;
+    }
+    
+    return true;
+}
+
+// Parse a decimal amount "[+-]digits[.digits]" of given length as integer cents, rounded to the nearest cent
+bool csv_parseCents(const char* text, int length, long long* cents) {
+    long long mantissa;
+    int decimals, next, i;
+    bool negative;
+    
+    assert(text != NULL);
+    assert(cents != NULL);
+    
+    if (!csv_parseDecimal(text, length, &mantissa, &decimals, &negative, 2, &next)) {
+        return false;
+    }
+    // Amounts that do not fit in cents are not valid
+    for (; decimals < 2; decimals++) {
+        if (mantissa > LLONG_MAX / 10) {
+            return false;
+        }
+        mantissa *= 10;
+    }
+    // Round with the first discarded decimal, the others only have to be digits
+    for (i = next; i < length; i++) {
+        if ((unsigned char) (text[i] - '0') > 9) {
+            return false;
+        }
+    }
+    if (next < length && text[next] >= '5') {
+        if (mantissa > LLONG_MAX - 1) {
+            return false;
+        }
+        mantissa++;
+    }
+    *cents = negative ? -mantissa : mantissa;
+    
+    return true;
+}
+
+// Map a whole CSV file in memory for reading
+bool csv_openFile(tCSVFile* file, const char* filename) {
+#ifdef CSV_USE_MMAP
+    int fd;
+    struct stat info;
+    void* map;
+#endif
+    
+    assert(file != NULL);
+    assert(filename != NULL);
+    
+    file->data = NULL;
+    file->size = 0;
+    
+#ifdef CSV_USE_MMAP
+    fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            // The file is walked once from the beginning to the end
+            madvise(map, info.st_size, MADV_SEQUENTIAL);
+            close(fd);
+            file->data = (const char*) map;
+            file->size = info.st_size;
+            return true;
+        }
+    }
+    close(fd);
+#endif
+    
+    return false;
+}
+
+// Release a CSV file mapped in memory
+void csv_closeFile(tCSVFile* file) {
+    assert(file != NULL);
+    
+#ifdef CSV_USE_MMAP
+    if (file->data != NULL) {
+        munmap((void*) file->data, file->size);
+    }
+#endif
+    file->data = NULL;
+    file->size = 0;
+}
+
+// Start reading the records of an open file descriptor
+void csv_readerOpenFd(tCSVReader* reader, int fd, int bufferSize) {
+    assert(reader != NULL);
+    assert(fd >= 0);
+    assert(bufferSize > 0);
+    
+    reader->fd = fd;
+    reader->ownsFd = false;
+    reader->buffer = (char*) malloc(bufferSize);
+    assert(reader->buffer != NULL);
+    reader->bufferSize = bufferSize;
+    reader->start = 0;
+    reader->end = 0;
+    reader->eof = false;
+    reader->offset = 0;
+    reader->recordOffset = -1;
+    reader->recordLine = 0;
+    reader->lines = 0;
+    csv_initEntry(&(reader->entry));
+}
+
+// Start reading the records of a file
+bool csv_readerOpen(tCSVReader* reader, const char* filename, int bufferSize) {
+    int fd;
+    
+    assert(reader != NULL);
+    assert(filename != NULL);
+    
+    fd = open(filename, O_RDONLY | O_BINARY);
+    if (fd < 0) {
+        return false;
+    }
+    csv_readerOpenFd(reader, fd, bufferSize);
+    reader->ownsFd = true;
+    
+    return true;
+}
+
+// Read more data from the file, keeping the unread bytes
+static void csv_readerFill(tCSVReader* reader) {
+    int n;
+    
+    // Move the unread bytes to the beginning of the buffer
+    if (reader->start > 0) {
+        memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+        reader->offset += reader->start;
+        reader->end -= reader->start;
+        reader->start = 0;
+    }
+    
+    // A line longer than the buffer makes it grow
+    if (reader->end == reader->bufferSize) {
+        reader->bufferSize *= 2;
+        reader->buffer = (char*) realloc(reader->buffer, reader->bufferSize);
+        assert(reader->buffer != NULL);
+    }
+    
+    n = read(reader->fd, reader->buffer + reader->end, reader->bufferSize - reader->end);
+    if (n <= 0) {
+        reader->eof = true;
+    } else {
+        reader->end += n;
+    }
+}
+
+// Read the next record. Returns NULL when there are no more records
+tCSVEntry* csv_readerNext(tCSVReader* reader, const char* type) {
+    const char* line;
+    int available, len;
+    
+    assert(reader != NULL);
+    
+    while (reader->start < reader->end || !reader->eof) {
+        available = reader->end - reader->start;
+        if (available > 0) {
+            len = csv_parseEntryView(&(reader->entry), reader->buffer + reader->start, available, type);
+            
+            // The line is complete if its new line was found or there is no more data
+            if (len < available || reader->eof) {
+                line = reader->buffer + reader->start;
+                reader->recordOffset = reader->offset + reader->start;
+                reader->lines++;
+                reader->recordLine = reader->lines;
+                reader->start += (len < available) ? len + 1 : len;
+                
+                // Skip empty lines
+                if (len > 1 || (len == 1 && line[0] != '\r')) {
+                    return &(reader->entry);
+                }
+                continue;
+            }
+        }
+        csv_readerFill(reader);
+    }
+    
+    return NULL;
+}
+
+// Get the offset in bytes of the last record read
+long long csv_readerOffset(tCSVReader* reader) {
+    return reader->recordOffset;
+}
+
+// Get the line number of the last record read, starting at 1
+int csv_readerLine(tCSVReader* reader) {
+    return reader->recordLine;
+}
+
+// Stop reading and release the reader
+void csv_readerClose(tCSVReader* reader) {
+    assert(reader != NULL);
+    
+    if (reader->ownsFd) {
+        close(reader->fd);
+    }
+    free(reader->buffer);
+    reader->buffer = NULL;
+    reader->bufferSize = 0;
+    reader->fd = -1;
+    csv_freeEntry(&(reader->entry));
+}
+
+// Start writing records to a file
+bool csv_writerOpen(tCSVWriter* writer, const char* filename, int bufferSize) {
+    int fd;
+    
+    assert(writer != NULL);
+    assert(filename != NULL);
+    
+    fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    csv_writerOpenFd(writer, fd, bufferSize);
+    writer->ownsFd = true;
+    
+    return true;
+}
+
+// Start writing records to an open file descriptor
+void csv_writerOpenFd(tCSVWriter* writer, int fd, int bufferSize) {
+    assert(writer != NULL);
+    assert(fd >= 0);
+    assert(bufferSize >= CSV_WRITER_MIN_BUFFER);
+    
+    writer->fd = fd;
+    writer->ownsFd = false;
+    writer->buffer = (char*) malloc(bufferSize);
+    assert(writer->buffer != NULL);
+    writer->bufferSize = bufferSize;
+    writer->used = 0;
+    writer->numFields = 0;
+    writer->failed = false;
+}
+
+// Write a block of bytes to the file, retrying partial writes
+static void csv_writerWrite(tCSVWriter* writer, const char* data, int length) {
+    int n;
+    
+    while (length > 0 && !writer->failed) {
+        n = write(writer->fd, data, length);
+        if (n <= 0) {
+            writer->failed = true;
+        } else {
+            data += n;
+            length -= n;
+        }
+    }
+}
+
+// Write the buffered records to the file
+bool csv_writerFlush(tCSVWriter* writer) {
+    assert(writer != NULL);
+    
+    csv_writerWrite(writer, writer->buffer, writer->used);
+    writer->used = 0;
+    
+    return !writer->failed;
+}
+
+// Get space on the buffer for a new field of at most the given length, adding the separator
+static char* csv_writerField(tCSVWriter* writer, int length) {
+    if (writer->used + length + 1 > writer->bufferSize) {
+        csv_writerFlush(writer);
+    }
+    if (writer->numFields > 0) {
+        writer->buffer[writer->used++] = ';';
+    }
+    writer->numFields++;
+    
+    return writer->buffer + writer->used;
+}
+
+// Write the digits of a positive number right aligned at the end of buffer, padded with zeros 
+// up to width. Returns the number of characters written
+static int csv_formatDigits(char* end, unsigned long long value, int width) {
+    char* p = end;
+    
+    do {
+        *--p = '0' + (char) (value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (end - p < width) {
+        *--p = '0';
+    }
+    
+    return end - p;
+}
+
+// Write a text field
+void csv_writeString(tCSVWriter* writer, const char* value) {
+    int len;
+    
+    assert(writer != NULL);
+    assert(value != NULL);
+    
+    len = strlen(value);
+    
+    // Texts that do not fit in the buffer are written directly
+    if (len + 1 > writer->bufferSize) {
+        csv_writerField(writer, 0);
+        csv_writerFlush(writer);
+        csv_writerWrite(writer, value, len);
+        return;
+    }
+    memcpy(csv_writerField(writer, len), value, len);
+    writer->used += len;
+}
+
+// Write an integer field
+void csv_writeInteger(tCSVWriter* writer, long long value) {
+    char digits[CSV_NUMBER_LENGTH];
+    char* p;
+    int len;
+    
+    assert(writer != NULL);
+    
+    len = csv_formatDigits(digits + CSV_NUMBER_LENGTH, 
+        (value < 0) ? 0ULL - (unsigned long long) value : (unsigned long long) value, 1);
+    if (value < 0) {
+        digits[CSV_NUMBER_LENGTH - ++len] = '-';
+    }
+    p = csv_writerField(writer, len);
+    memcpy(p, digits + CSV_NUMBER_LENGTH - len, len);
+    writer->used += len;
+}
+
+// Write a decimal field with the given number of decimals
+void csv_writeReal(tCSVWriter* writer, double value, int decimals) {
+    static const double scales[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+    char digits[CSV_NUMBER_LENGTH];
+    char large[CSV_LARGE_NUMBER_LENGTH];
+    unsigned long long scaled, scale;
+    bool negative;
+    char* p;
+    int len;
+    
+    assert(writer != NULL);
+    assert(decimals >= 0 && decimals < 10);
+    
+    negative = value < 0;
+    if (negative) {
+        value = -value;
+    }
+    
+    // Values that do not fit in an integer once scaled, and NaN, use the standard library
+    if (!(value * scales[decimals] < 9.0e18)) {
+        snprintf(large, CSV_LARGE_NUMBER_LENGTH, "%.*f", decimals, negative ? -value : value);
+        csv_writeString(writer, large);
+        return;
+    }
+    
+    // Write the integer part and the decimals of the rounded value
+    scaled = (unsigned long long) (value * scales[decimals] + 0.5);
+    scale = (unsigned long long) scales[decimals];
+    p = digits + CSV_NUMBER_LENGTH;
+    len = 0;
+    if (decimals > 0) {
+        len = csv_formatDigits(p, scaled % scale, decimals);
+        digits[CSV_NUMBER_LENGTH - ++len] = '.';
+    }
+    len += csv_formatDigits(p - len, scaled / scale, 1);
+    if (negative && scaled != 0) {
+        digits[CSV_NUMBER_LENGTH - ++len] = '-';
+    }
+    p = csv_writerField(writer, len);
+    memcpy(p, digits + CSV_NUMBER_LENGTH - len, len);
+    writer->used += len;
+}
+
+// Write a date field as dd/mm/yyyy
+void csv_writeDate(tCSVWriter* writer, int day, int month, int year) {
+    char* p;
+    
+    assert(writer != NULL);
+    assert(day >= 0 && day < 100 && month >= 0 && month < 100 && year >= 0 && year < 10000);
+    
+    p = csv_writerField(writer, 10);
+    csv_formatDigits(p + 2, day, 2);
+    p[2] = '/';
+    csv_formatDigits(p + 5, month, 2);
+    p[5] = '/';
+    csv_formatDigits(p + 10, year, 4);
+    writer->used += 10;
+}
+
+// Finish the current record
+void csv_writeEndRecord(tCSVWriter* writer) {
+    assert(writer != NULL);
+    
+    if (writer->used == writer->bufferSize) {
+        csv_writerFlush(writer);
+    }
+    writer->buffer[writer->used++] = '\n';
+    writer->numFields = 0;
+}
+
+// Stop writing and release the writer
+bool csv_writerClose(tCSVWriter* writer) {
+    bool ok;
+    
+    assert(writer != NULL);
+    
+    ok = csv_writerFlush(writer);
+    if (writer->ownsFd) {
+        ok = (close(writer->fd) == 0) && ok;
+    }
+    free(writer->buffer);
+    writer->buffer = NULL;
+    writer->bufferSize = 0;
+    writer->fd = -1;
+    
+    return ok;
 }
 
 // Compare if two entries are the same
@@ -237,11 +1205,11 @@ bool csv_equalsEntry(tCSVEntry entry1, tCSVEntry entry2) {
     if (entry1.numFields != entry2.numFields) {
         return false;
     }
-    if (strcmp(entry1.type, entry2.type) != 0) {
+    if (entry1.typeId != entry2.typeId || strcmp(entry1.type, entry2.type) != 0) {
         return false;
     }
     for (i = 0; i < entry1.numFields ; i++) {
-        if (strcmp(entry1.fields[i], entry2.fields[i]) != 0) {
+        if (strcmp(csv_fieldPtr(&entry1, i), csv_fieldPtr(&entry2, i)) != 0) {
             return false;
         }
     }
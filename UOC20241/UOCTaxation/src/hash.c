@@ -0,0 +1,137 @@
+#include <stdlib.h>
+#include <assert.h>
+#include "hash.h"
+
+// Initial number of slots of an index. It must be a power of two
+#define HASH_INITIAL_CAPACITY 16
+
+// Find the slot of a key, or the empty slot where it would be placed
+static tHashSlot* hashIndex_probe(const tHashIndex* index, tKey key) {
+    unsigned int mask = index->capacity - 1;
+    unsigned int i = key_hash(key, index->bits);
+    
+    while (index->slots[i].position >= 0 && index->slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    
+    return &(index->slots[i]);
+}
+
+// Set the number of slots, placing again the existing keys
+static void hashIndex_resize(tHashIndex* index, int capacity) {
+    tHashIndex old = *index;
+    tHashSlot* slot;
+    int i;
+    
+    index->slots = (tHashSlot*) malloc(capacity * sizeof(tHashSlot));
+    assert(index->slots != NULL);
+    index->capacity = capacity;
+    index->bits = 0;
+    while ((1 << index->bits) < capacity) {
+        index->bits++;
+    }
+    for (i = 0; i < capacity; i++) {
+        index->slots[i].position = -1;
+    }
+    
+    for (i = 0; i < old.capacity; i++) {
+        if (old.slots[i].position >= 0) {
+            slot = hashIndex_probe(index, old.slots[i].key);
+            *slot = old.slots[i];
+        }
+    }
+    free(old.slots);
+}
+
+// Initialize an empty index
+void hashIndex_init(tHashIndex* index) {
+    // Check input data (Pre-conditions)
+    assert(index != NULL);
+    
+    index->slots = NULL;
+    index->capacity = 0;
+    index->bits = 0;
+    index->count = 0;
+}
+
+// Make room for count keys
+void hashIndex_reserve(tHashIndex* index, int count) {
+    int capacity = HASH_INITIAL_CAPACITY;
+    
+    // Check input data (Pre-conditions)
+    assert(index != NULL);
+    assert(count >= 0);
+    
+    // Keep at least half of the slots empty, as hashIndex_add does
+    while (capacity < 2 * count) {
+        capacity *= 2;
+    }
+    if (capacity > index->capacity) {
+        hashIndex_resize(index, capacity);
+    }
+}
+
+// Add a key with its position. Returns false if the key already exists
+bool hashIndex_add(tHashIndex* index, tKey key, int position, int subposition) {
+    tHashSlot* slot;
+    
+    // Check input data (Pre-conditions)
+    assert(index != NULL);
+    assert(key != KEY_INVALID);
+    assert(position >= 0);
+    
+    // Keep at least half of the slots empty
+    if (2 * (index->count + 1) > index->capacity) {
+        hashIndex_resize(index, (index->capacity == 0) ? HASH_INITIAL_CAPACITY : index->capacity * 2);
+    }
+    
+    slot = hashIndex_probe(index, key);
+    if (slot->position >= 0) {
+        return false;
+    }
+    slot->key = key;
+    slot->position = position;
+    slot->subposition = subposition;
+    index->count++;
+    
+    return true;
+}
+
+// Find the slot of a key. Returns NULL if it does not exist
+tHashSlot* hashIndex_find(const tHashIndex* index, tKey key) {
+    tHashSlot* slot;
+    
+    // Check input data (Pre-conditions)
+    assert(index != NULL);
+    
+    if (index->count == 0 || key == KEY_INVALID) {
+        return NULL;
+    }
+    slot = hashIndex_probe(index, key);
+    
+    return (slot->position >= 0) ? slot : NULL;
+}
+
+// Remove all the keys, keeping the memory
+void hashIndex_clear(tHashIndex* index) {
+    int i;
+    
+    // Check input data (Pre-conditions)
+    assert(index != NULL);
+    
+    for (i = 0; i < index->capacity; i++) {
+        index->slots[i].position = -1;
+    }
+    index->count = 0;
+}
+
+// Release the index
+void hashIndex_free(tHashIndex* index) {
+    // Check input data (Pre-conditions)
+    assert(index != NULL);
+    
+    if (index->slots != NULL) {
+        free(index->slots);
+    }
+    hashIndex_init(index);
+}
@@ -0,0 +1,52 @@
+#include <stdlib.h>
+#include <assert.h>
+#include "key.h"
+
+// Bits of each character of a key
+#define KEY_CHAR_BITS 7
+
+// Pack a text in a key
+tKey key_pack(const char* text) {
+    tKey key = 0;
+    unsigned char c;
+    int i;
+    
+    // Check input data (Pre-conditions)
+    assert(text != NULL);
+    
+    for (i = 0; i < KEY_MAX_LENGTH && text[i] != '\0'; i++) {
+        c = (unsigned char) text[i];
+        if (c > 0x7f) {
+            return KEY_INVALID;
+        }
+        key |= (tKey) c << (KEY_CHAR_BITS * (KEY_MAX_LENGTH - 1 - i));
+    }
+    if (i == KEY_MAX_LENGTH && text[i] != '\0') {
+        return KEY_INVALID;
+    }
+    
+    return key;
+}
+
+// Unpack a key into a buffer of at least KEY_MAX_LENGTH + 1 characters
+void key_unpack(tKey key, char* buffer) {
+    int i;
+    
+    // Check input data (Pre-conditions)
+    assert(key != KEY_INVALID);
+    assert(buffer != NULL);
+    
+    for (i = 0; i < KEY_MAX_LENGTH; i++) {
+        buffer[i] = (char) ((key >> (KEY_CHAR_BITS * (KEY_MAX_LENGTH - 1 - i))) & 0x7f);
+    }
+    buffer[KEY_MAX_LENGTH] = '\0';
+}
+
+// Hash of a key in the range [0, 2^bits). Fibonacci hashing: the highest bits of the product are the best mixed,
+// so they are the ones taken
+unsigned int key_hash(tKey key, int bits) {
+    // Check input data (Pre-conditions)
+    assert(bits > 0 && bits <= 32);
+    
+    return (unsigned int) ((key * 0x9e3779b97f4a7c15ull) >> (64 - bits));
+}
@@ -4,6 +4,12 @@
 #include <stdio.h>
 #include "landlord.h"
 
+// Initial number of properties of a landlord. Most landlords own one or two
+#define PROPERTIES_INITIAL_CAPACITY 2
+
+// Initial number of landlords of the data
+#define LANDLORDS_INITIAL_CAPACITY 16
+
 //////////////////////////////////
 // Available methods
 //////////////////////////////////
@@ -13,6 +19,8 @@ void properties_init(tProperties* data) {
     /////////////
     // Set the initial number of elements to zero.
     data->count = 0;
+    data->capacity = 0;
+    data->elems = NULL;
     /////////////
 }
 
@@ -24,12 +32,29 @@ int properties_len(tLandlord data) {
     //////////////
 }
 
+// Release the properties
+void properties_free(tProperties* data) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    
+    if (data->elems != NULL) {
+        free(data->elems);
+    }
+    properties_init(data);
+}
+
 // Initialize the landlords
 void landlords_init(tLandlords* data) {   
     /////////////
     // Set the initial number of elements to zero.
     data->count = 0;
+    data->capacity = 0;
 	data->elems = NULL;
+    data->ids = NULL;
+    data->taxes = NULL;
+    data->names = NULL;
+    hashIndex_init(&(data->index));
+    hashIndex_init(&(data->properties));
     /////////////
 }
 
@@ -48,34 +73,88 @@ int landlords_propertiesCount(tLandlords data) {
     
     // Iterate all landlords
     for (i = 0; i < data.count; i++) {
-        count += properties_len(data.elems[i]);
+        count += data.elems[i].properties.count;
     }
     
     return count;
 }
 
+// Get the tax of the landlord in the given position
+tMoney landlords_tax(const tLandlords* data, int index) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    assert(index >= 0 && index < data->count);
+    
+    return data->taxes[index];
+}
+
+// Add an amount to the tax of the landlord in the given position
+void landlords_addTax(tLandlords* data, int index, tMoney amount) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    assert(index >= 0 && index < data->count);
+    
+    data->elems[index].tax += amount;
+    data->taxes[index] = data->elems[index].tax;
+}
+
+// Get the packed id of the landlord in the given position
+tKey landlords_key(const tLandlords* data, int index) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    assert(index >= 0 && index < data->count);
+    
+    return data->ids[index];
+}
+
+// Get the name of the landlord in the given position
+const char* landlords_name(const tLandlords* data, int index) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    assert(index >= 0 && index < data->count);
+    
+    return data->names[index];
+}
+
+// Get the sum of the tax of all landlords
+tMoney landlords_totalTax(const tLandlords* data) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    
+    // The taxes are summed straight from their column
+    return money_sum(data->taxes, data->count);
+}
+
+// Copy the id, tax and name of the landlord in the given position to the columns
+static void landlords_setColumns(tLandlords* data, int index) {
+    data->ids[index] = key_pack(data->elems[index].id);
+    data->taxes[index] = data->elems[index].tax;
+    data->names[index] = data->elems[index].name;
+}
+
 
 ////////////////////////////////////////
 void landlords_process_tenant(tLandlords* data, tTenant tenant) {
     int idx;
+    int property_idx;
 
     // Check input data (Pre-conditions)
     assert(data != NULL);    
     
     // Check if an entry with this data already exists
-    idx = landlords_find_by_cadastral_ref(*data, tenant.cadastral_ref);
+    idx = landlords_find_property_ptr(data, tenant.cadastral_ref, &property_idx);
     
     // If it does not exist, create a new entry
     if (idx >= 0) {
         int months_rented = tenant.end_date.month - tenant.start_date.month + 1;
-        float tax_factor;
-        float amount_to_add;
+        int tax_percent;
+        tMoney amount_to_add;
         if (tenant.age <= 35)
-            tax_factor = 0.1;
+            tax_percent = 10;
         else 
-            tax_factor = 0.2;
-        amount_to_add = months_rented * tenant.rent * tax_factor - AMOUNT_NO_RENT * months_rented;
-        data->elems[idx].tax = data->elems[idx].tax + amount_to_add;
+            tax_percent = 20;
+        amount_to_add = money_percent(months_rented * tenant.rent, tax_percent) - AMOUNT_NO_RENT * months_rented;
+        landlords_addTax(data, idx, amount_to_add);
     }
 }
 
@@ -92,16 +171,29 @@ void property_get(tLandlord data, int index, char* buffer) {
 }
 
 // Parse input from CSVEntry
-void property_parse(tProperty* data, tCSVEntry entry) {
+bool property_parse(tProperty* data, tCSVEntry entry) {
+    return property_parse_ptr(data, &entry);
+}
+
+// Parse input from CSVEntry, taking the entry by pointer
+bool property_parse_ptr(tProperty* data, const tCSVEntry* entry) {
+    bool valid;
+    
     // Check input data (Pre-conditions)
     assert(data != NULL);    
-    assert(csv_numFields(entry) == NUM_FIELDS_PROPERTY);
+    assert(csv_numFields_ptr(entry) == NUM_FIELDS_PROPERTY);
     
     // Get the date and time
-    csv_getAsString(entry, 0, data->cadastral_ref, MAX_CADASTRAL_REF + 1);    
-    csv_getAsString(entry, 1, data->address.street, MAX_STREET + 1);    
-    data->address.number = csv_getAsInteger(entry, 2);
-    csv_getAsString(entry, 3, data->landlord_id, MAX_PERSON_ID + 1);    
+    csv_getAsString_ptr(entry, 0, data->cadastral_ref, MAX_CADASTRAL_REF + 1);    
+    csv_getAsString_ptr(entry, 1, data->address.street, MAX_STREET + 1);    
+    valid = csv_tryGetAsInteger_ptr(entry, 2, &(data->address.number));
+    csv_getAsString_ptr(entry, 3, data->landlord_id, MAX_PERSON_ID + 1);    
+    
+    // All the fields are required, and ids are packed in keys to index them
+    valid = valid && !csv_hasEmptyField(entry) && 
+            key_pack(data->cadastral_ref) != KEY_INVALID && key_pack(data->landlord_id) != KEY_INVALID;
+    
+    return valid;
 }
 
 ////////////////////////////////////////
@@ -109,35 +201,46 @@ void property_parse(tProperty* data, tCSVEntry entry) {
 // Add a new property
 void landlord_add_property(tLandlords* data, tProperty property) {
     int idx_landlord;
+    tKey ref;
 
     // Check input data (Pre-conditions)
     assert(data != NULL);    
     
-    idx_landlord = landlords_find(*data, property.landlord_id);
-    if (idx_landlord >= 0) {
-        int idx_property = -1;
-
-        // Check if an entry with this data already exists
-        idx_property = properties_find(data->elems[idx_landlord].properties, property.cadastral_ref);
-        
-        // If it does not exist, create a new entry
-        if (idx_property < 0) {
-            int property_count = data->elems[idx_landlord].properties.count;
-            assert(property_count < MAX_PROPERTIES);
-            property_cpy(&(data->elems[idx_landlord].properties.elems[property_count]), property);
-            data->elems[idx_landlord].properties.count++;
-            data->elems[idx_landlord].tax = data->elems[idx_landlord].tax + AMOUNT_NO_RENT*12;
+    idx_landlord = landlords_find_ptr(data, property.landlord_id);
+    ref = key_pack(property.cadastral_ref);
+    if (idx_landlord >= 0 && ref != KEY_INVALID) {
+        // If no landlord has this property, create a new entry
+        if (hashIndex_find(&(data->properties), ref) == NULL) {
+            tProperties* properties = &(data->elems[idx_landlord].properties);
+            if (properties->count == properties->capacity) {
+                properties->capacity = (properties->capacity == 0) ? 
+                    PROPERTIES_INITIAL_CAPACITY : properties->capacity * 2;
+                properties->elems = (tProperty*) realloc(properties->elems, properties->capacity * sizeof(tProperty));
+                assert(properties->elems != NULL);
+            }
+            property_cpy(&(properties->elems[properties->count]), property);
+            hashIndex_add(&(data->properties), ref, idx_landlord, properties->count);
+            properties->count++;
+            landlords_addTax(data, idx_landlord, AMOUNT_NO_RENT*12);
         }
     }
 }
 
 // Get a landlord
 void landlord_get(tLandlords data, int index, char* buffer) {
-    assert(index < data.count);
+    landlord_get_ptr(&data, index, buffer);
+}
+
+// Get a landlord, taking the landlords by pointer
+void landlord_get_ptr(const tLandlords* data, int index, char* buffer) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    assert(index < data->count);
+    
     sprintf(buffer, "%s;%s,%.1f", 
-        data.elems[index].name,
-        data.elems[index].id,
-        data.elems[index].tax
+        landlords_name(data, index),
+        data->elems[index].id,
+        money_toReal(landlords_tax(data, index))
     );
 }
 
@@ -147,26 +250,39 @@ void landlord_init(tLandlord* data) {
     assert(data != NULL);    
     
     data->name = NULL;
+    properties_init(&(data->properties));
 }
 
 // Parse input from CSVEntry
-void landlord_parse(tLandlord* data, tCSVEntry entry) {
+bool landlord_parse(tLandlord* data, tCSVEntry entry) {
+    return landlord_parse_ptr(data, &entry);
+}
+
+// Parse input from CSVEntry, taking the entry by pointer
+bool landlord_parse_ptr(tLandlord* data, const tCSVEntry* entry) {
+    bool valid;
+    
     // Check input data (Pre-conditions)
     assert(data != NULL);    
-    assert(csv_numFields(entry) == NUM_FIELDS_LANDLORD);
-    data->properties.count = 0;
+    assert(csv_numFields_ptr(entry) == NUM_FIELDS_LANDLORD);
     
-    data->name = (char*) malloc((strlen(entry.fields[0]) + 1) * sizeof(char));
+    data->name = (char*) malloc((csv_getFieldLength_ptr(entry, 0) + 1) * sizeof(char));
     assert(data->name != NULL);
-    memset(data->name, 0, (strlen(entry.fields[0]) + 1) * sizeof(char));
-    csv_getAsString(entry, 0, data->name, strlen(entry.fields[0]) + 1);    
+    memset(data->name, 0, (csv_getFieldLength_ptr(entry, 0) + 1) * sizeof(char));
+    csv_getAsString_ptr(entry, 0, data->name, csv_getFieldLength_ptr(entry, 0) + 1);    
     
-    csv_getAsString(entry, 1, data->id, MAX_PERSON_ID + 1);    
+    csv_getAsString_ptr(entry, 1, data->id, MAX_PERSON_ID + 1);    
     
-    data->tax = csv_getAsInteger(entry, 2);
+    // All the fields are required, and ids are packed in keys to index them
+    valid = csv_tryGetAsCents_ptr(entry, 2, &(data->tax));
+    valid = valid && !csv_hasEmptyField(entry) && key_pack(data->id) != KEY_INVALID;
+    // The id must be a DNI or NIE with the right control letter
+    valid = valid && personId_isValid(data->id);
     
     // Initialize the properties
     properties_init(&(data->properties));
+    
+    return valid;
 }
 
 // Release a landlord
@@ -179,34 +295,114 @@ void landlord_free(tLandlord* data) {
         free(data->name);
     }
     data->name = NULL;
+    
+    // Release the properties
+    properties_free(&(data->properties));
 }
 
 ////////////////////////////////////////
 
+// Allocate memory for a new landlord. The capacity is doubled, so adding n landlords copies O(n) landlords
+static void landlords_grow(tLandlords* data) {
+    if (data->count == data->capacity) {
+        landlords_reserve(data, (data->capacity == 0) ? LANDLORDS_INITIAL_CAPACITY : data->capacity * 2);
+    }
+}
+
+// Make room for at least capacity landlords
+void landlords_reserve(tLandlords* data, int capacity) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    
+    if (capacity > data->capacity) {
+        data->elems = (tLandlord*) realloc(data->elems, capacity * sizeof(tLandlord));
+        data->ids = (tKey*) realloc(data->ids, capacity * sizeof(tKey));
+        data->taxes = (tMoney*) realloc(data->taxes, capacity * sizeof(tMoney));
+        data->names = (char**) realloc(data->names, capacity * sizeof(char*));
+        assert(data->elems != NULL && data->ids != NULL && data->taxes != NULL && data->names != NULL);
+        data->capacity = capacity;
+        hashIndex_reserve(&(data->index), capacity);
+    }
+}
+
+// Make room in the index of properties for count properties of all the landlords
+void landlords_reserveProperties(tLandlords* data, int count) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    
+    hashIndex_reserve(&(data->properties), count);
+}
+
+// Release the memory reserved for landlords that have not been added
+void landlords_shrink(tLandlords* data) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    
+    if (data->count == 0) {
+        free(data->elems);
+        free(data->ids);
+        free(data->taxes);
+        free(data->names);
+        data->elems = NULL;
+        data->ids = NULL;
+        data->taxes = NULL;
+        data->names = NULL;
+    } else if (data->count < data->capacity) {
+        data->elems = (tLandlord*) realloc(data->elems, data->count * sizeof(tLandlord));
+        data->ids = (tKey*) realloc(data->ids, data->count * sizeof(tKey));
+        data->taxes = (tMoney*) realloc(data->taxes, data->count * sizeof(tMoney));
+        data->names = (char**) realloc(data->names, data->count * sizeof(char*));
+        assert(data->elems != NULL && data->ids != NULL && data->taxes != NULL && data->names != NULL);
+    }
+    data->capacity = data->count;
+}
+
 // Add a new landlord
 void landlords_add(tLandlords* data, tLandlord landlord) {
-    int idx;
+    tKey key;
 
     // Check input data (Pre-conditions)
     assert(data != NULL);    
     
     // Check if an entry with this data already exists
-    idx = landlords_find(*data, landlord.id);
+    key = key_pack(landlord.id);
     
-    // If it does not exist, create a new entry
-    if (idx < 0) {
-        if (data->elems == NULL) {
-            data->elems = (tLandlord*) malloc(sizeof(tLandlord));
-        } else {
-            data->elems = (tLandlord*) realloc(data->elems, (data->count + 1) * sizeof(tLandlord));
-        }
-        assert(data->elems != NULL);
+    // If it does not exist and its id can be indexed, create a new entry
+    if (key != KEY_INVALID && hashIndex_find(&(data->index), key) == NULL) {
+        landlords_grow(data);
         /////////////////////////////////  
         landlord_cpy(&(data->elems[data->count]), landlord);
+        landlords_setColumns(data, data->count);
+        hashIndex_add(&(data->index), key, data->count, -1);
         data->count++;        
     }
 }
 
+// Add a new landlord, taking the ownership of its name and properties
+bool landlords_add_move(tLandlords* data, tLandlord* landlord) {
+    tKey key;
+    
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    assert(landlord != NULL);
+    
+    // The index rejects existing landlords
+    key = key_pack(landlord->id);
+    if (key == KEY_INVALID || !hashIndex_add(&(data->index), key, data->count, -1)) {
+        return false;
+    }
+    
+    // Move the landlord to the new position, leaving the source without memory
+    landlords_grow(data);
+    data->elems[data->count] = *landlord;
+    landlords_setColumns(data, data->count);
+    landlord->name = NULL;
+    properties_init(&(landlord->properties));
+    data->count++;
+    
+    return true;
+}
+
 // Remove a landlord
 void landlords_del(tLandlords* data, char* id) 
 {
@@ -214,20 +410,24 @@ void landlords_del(tLandlords* data, char* id)
     int i;
     
     // Check if an entry with this data already exists
-    idx = landlords_find(*data, id);
+    idx = landlords_find_ptr(data, id);
     
     if (idx >= 0) {
+        // Release the selected element
+        landlord_free(&(data->elems[idx]));
+        
         // Shift elements to remove selected
         for(i = idx; i < data->count-1; i++) {
-                // Copy element on position i+1 to position i
-                landlord_cpy(&(data->elems[i]), data->elems[i+1]);
+                // Move element on position i+1 to position i
+                data->elems[i] = data->elems[i+1];
         }
         // Update the number of elements
         data->count--;  
         /////////////////////////////////
         if (data->count > 0) {
-            data->elems = (tLandlord*) realloc(data->elems, data->count * sizeof(tLandlord));
-            assert(data->elems != NULL);
+            // The following landlords have moved, so the indexes and columns are built again. The memory is
+            // kept for new landlords, see landlords_shrink
+            landlords_reindex(data);
         } else {
 			landlords_free(data);
         }
@@ -237,61 +437,113 @@ void landlords_del(tLandlords* data, char* id)
 
 // returns true if field tax of expected[index] is greater than the one in declarant[index]
 bool mismatch_tax_declaration(tLandlords expected, tLandlords declarant, int index) {
-    return (expected.elems[index].tax > declarant.elems[index].tax);
+    return mismatch_tax_declaration_ptr(&expected, &declarant, index);
+}
+
+// Same as mismatch_tax_declaration, taking the landlords by pointer
+bool mismatch_tax_declaration_ptr(const tLandlords* expected, const tLandlords* declarant, int index) {
+    // Check input data (Pre-conditions)
+    assert(expected != NULL);
+    assert(declarant != NULL);
+    
+    return (landlords_tax(expected, index) > landlords_tax(declarant, index));
 }
 
 // Copy the data from the source to destination
 void landlords_cpy(tLandlords* destination, tLandlords source) {
     int i;
 
+    landlords_init(destination);
+    landlords_reserve(destination, source.count);
     destination->count = source.count;
-	destination->elems = (tLandlord*) malloc(source.count * sizeof(tLandlord));
 	
     for(i = 0 ; i < landlords_len(source) ; i++) {
         landlord_cpy(&(destination->elems[i]), source.elems[i]);
         // we want to copy all fields from source.elems[i] but want 
         // to set tax to 0 in the expected landlords
-        destination->elems[i].tax = 0.0;
+        destination->elems[i].tax = 0;
     }    
+    landlords_reindex(destination);
 }
 
 // [AUX METHOD] Return the position of a tenant entry with provided information. -1 if it does not exist
 int landlords_find(tLandlords data, const char* id) {
-    int i;
-    int res = -1;
+    return landlords_find_ptr(&data, id);
+}
 
-    i = 0;
-    while ((i < data.count) && (res < 0)) {
-        if((strcmp(data.elems[i].id, id) == 0)) {
-            res = i;
+// [AUX METHOD] Same as landlords_find, taking the landlords by pointer
+int landlords_find_ptr(const tLandlords* data, const char* id) {
+    tHashSlot* slot;
+    
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    
+    slot = hashIndex_find(&(data->index), key_pack(id));
+    
+    return (slot != NULL) ? slot->position : -1;
+}
+
+// [AUX METHOD] Build again the indexes and the columns of the landlords and their properties from the elements
+bool landlords_reindex(tLandlords* data) {
+    tKey key;
+    bool valid = true;
+    int i, j;
+    
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    
+    hashIndex_clear(&(data->index));
+    hashIndex_clear(&(data->properties));
+    for (i = 0; i < data->count; i++) {
+        landlords_setColumns(data, i);
+        if (data->ids[i] != KEY_INVALID) {
+            hashIndex_add(&(data->index), data->ids[i], i, -1);
+        } else {
+            valid = false;
+        }
+        for (j = 0; j < data->elems[i].properties.count; j++) {
+            key = key_pack(data->elems[i].properties.elems[j].cadastral_ref);
+            if (key != KEY_INVALID) {
+                hashIndex_add(&(data->properties), key, i, j);
+            } else {
+                valid = false;
+            }
         }
-        else {
-            i++;
-        } 
     }
     
-    return res;
+    return valid;
 }
 
 
 // [AUX METHOD] Return the position of a tenant entry with provided information. -1 if it does not exist
 int landlords_find_by_cadastral_ref(tLandlords data, const char* id) {
-    int i, j;
-    int res = -1;
+    int property_idx;
+    
+    return landlords_find_property_ptr(&data, id, &property_idx);
+}
 
-    i = 0;
-    while ((i < data.count) && (res < 0)) {
-        j = 0;
-        while ((j < data.elems[i].properties.count) && (res < 0)) {
-            if((strcmp(data.elems[i].properties.elems[j].cadastral_ref, id) == 0)) {
-                res = i;
-            }
-            j++;
-        }
-        i++;
+// [AUX METHOD] Return the position of the landlord that has a property with that cadastral ref, and the 
+// position of the property in property_idx. -1 if it does not exist
+int landlords_find_property(tLandlords data, const char* cadastral_ref, int* property_idx) {
+    return landlords_find_property_ptr(&data, cadastral_ref, property_idx);
+}
+
+// [AUX METHOD] Same as landlords_find_property, taking the landlords by pointer
+int landlords_find_property_ptr(const tLandlords* data, const char* cadastral_ref, int* property_idx) {
+    tHashSlot* slot;
+    
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    assert(property_idx != NULL);
+    
+    slot = hashIndex_find(&(data->properties), key_pack(cadastral_ref));
+    if (slot == NULL) {
+        *property_idx = -1;
+        return -1;
     }
+    *property_idx = slot->subposition;
     
-    return res;
+    return slot->position;
 }
 
 
@@ -311,6 +563,12 @@ void landlord_cpy(tLandlord* destination, tLandlord source) {
 void properties_cpy(tProperties *destination, tProperties source) {
     int i;
     
+    properties_init(destination);
+    if (source.count > 0) {
+        destination->elems = (tProperty*) malloc(source.count * sizeof(tProperty));
+        assert(destination->elems != NULL);
+        destination->capacity = source.count;
+    }
     for (i = 0; i < source.count; i++) {
         property_cpy(&(destination->elems[i]), source.elems[i]);
     }
@@ -320,12 +578,17 @@ void properties_cpy(tProperties *destination, tProperties source) {
 
 // [AUX METHOD] Return the position of a property entry with provided information. -1 if it does not exist
 int properties_find(tProperties data, const char* cadastral_ref) {
+    return properties_find_ptr(&data, cadastral_ref);
+}
+
+// [AUX METHOD] Same as properties_find, taking the properties by pointer
+int properties_find_ptr(const tProperties* data, const char* cadastral_ref) {
     int i;
     int res = -1;
 
     i = 0;
-    while ((i < data.count) && (res < 0)) {
-        if((strcmp(data.elems[i].cadastral_ref, cadastral_ref) == 0)) {
+    while ((i < data->count) && (res < 0)) {
+        if((strcmp(data->elems[i].cadastral_ref, cadastral_ref) == 0)) {
             res = i;
         }
         else {
@@ -345,10 +608,20 @@ void property_cpy(tProperty* destination, tProperty source) {
 
 // Remove all elements 
 void landlords_free(tLandlords* data) { 
+    int i;
+    
     /////////////////////////////////
+    for (i = 0; i < data->count; i++) {
+        landlord_free(&(data->elems[i]));
+    }
     if (data->elems != NULL) {
         free(data->elems);
+        free(data->ids);
+        free(data->taxes);
+        free(data->names);
     }
+    hashIndex_free(&(data->index));
+    hashIndex_free(&(data->properties));
     landlords_init(data);
     /////////////////////////////////    
 }
@@ -0,0 +1,113 @@
+#include <stdlib.h>
+#include <assert.h>
+#include "money.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MONEY_USE_SIMD
+#endif
+
+// Function that sums count amounts
+typedef tMoney (*tMoneySum)(const tMoney* values, int count);
+
+// Get the given percentage of an amount, rounded half away from zero to the nearest cent
+tMoney money_percent(tMoney amount, int percent) {
+    tMoney scaled = amount * percent;
+
+    if (scaled >= 0) {
+        return (scaled + 50) / 100;
+    }
+
+    return -((-scaled + 50) / 100);
+}
+
+// Get an amount as a real number of units, to print or write it
+double money_toReal(tMoney amount) {
+    return (double) amount / MONEY_CENTS;
+}
+
+// Sum count amounts one at a time
+static tMoney money_sumScalar(const tMoney* values, int count) {
+    tMoney total = 0;
+    int i;
+
+    for (i = 0; i < count; i++) {
+        total += values[i];
+    }
+
+    return total;
+}
+
+#ifdef MONEY_USE_SIMD
+// Sum count amounts 4 at a time, in 2 independent lanes. Integer additions are exact in any order
+__attribute__((target("sse2")))
+static tMoney money_sumSSE2(const tMoney* values, int count) {
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    long long lanes[2];
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        acc0 = _mm_add_epi64(acc0, _mm_loadu_si128((const __m128i*) (values + i)));
+        acc1 = _mm_add_epi64(acc1, _mm_loadu_si128((const __m128i*) (values + i + 2)));
+    }
+    _mm_storeu_si128((__m128i*) lanes, _mm_add_epi64(acc0, acc1));
+
+    return lanes[0] + lanes[1] + money_sumScalar(values + i, count - i);
+}
+
+// Sum count amounts 8 at a time, in 4 independent lanes
+__attribute__((target("avx2")))
+static tMoney money_sumAVX2(const tMoney* values, int count) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    long long lanes[4];
+    int i;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_loadu_si256((const __m256i*) (values + i)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_loadu_si256((const __m256i*) (values + i + 4)));
+    }
+    _mm256_storeu_si256((__m256i*) lanes, _mm256_add_epi64(acc0, acc1));
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + money_sumScalar(values + i, count - i);
+}
+#endif
+
+// Select the best sum for this CPU on the first call
+static tMoney money_sumInit(const tMoney* values, int count);
+
+// Sum in use. Several threads may select it at the same time, so it is accessed atomically
+static tMoneySum money_sumKernel = money_sumInit;
+#ifdef __GNUC__
+#define MONEY_GET_SUM() __atomic_load_n(&money_sumKernel, __ATOMIC_RELAXED)
+#define MONEY_SET_SUM(sum) __atomic_store_n(&money_sumKernel, (sum), __ATOMIC_RELAXED)
+#else
+#define MONEY_GET_SUM() money_sumKernel
+#define MONEY_SET_SUM(sum) (money_sumKernel = (sum))
+#endif
+
+// Select the best sum for this CPU on the first call
+static tMoney money_sumInit(const tMoney* values, int count) {
+    tMoneySum sum = money_sumScalar;
+
+#ifdef MONEY_USE_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        sum = money_sumAVX2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        sum = money_sumSSE2;
+    }
+#endif
+    MONEY_SET_SUM(sum);
+
+    return sum(values, count);
+}
+
+// Sum count amounts, with the widest vector instructions of the CPU
+tMoney money_sum(const tMoney* values, int count) {
+    // Check input data (Pre-conditions)
+    assert(values != NULL || count == 0);
+    assert(count >= 0);
+
+    return MONEY_GET_SUM()(values, count);
+}
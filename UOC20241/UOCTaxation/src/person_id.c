@@ -0,0 +1,211 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "person_id.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define PERSON_ID_USE_SIMD
+#endif
+
+// Number of ids whose weighted sums are computed on each call to a kernel
+#define PERSON_ID_BLOCK 64
+
+// Compute the weighted sum of the digits of count ids of a block, or -1 for ids with other characters
+typedef void (*tPersonIdSums)(const char* ids, int count, int* sums);
+
+// Control letter of each remainder of the number modulo 23
+static const char personId_letters[] = "TRWAGMYFPDXBNJZSQVHLCKE";
+
+// Weight of each digit, 10^(7-i) modulo 23, so the remainder of the number is the one of the weighted sum
+static const int personId_weights[PERSON_ID_LENGTH - 1] = {14, 6, 19, 18, 11, 8, 10, 1};
+
+// Weighted sum of the digits of an id, replacing the first letter of a NIE by its digit. -1 if a character
+// is not a digit
+static int personId_sum(const char* id) {
+    int sum = 0;
+    int digit, i;
+
+    for (i = 0; i < PERSON_ID_LENGTH - 1; i++) {
+        digit = id[i] - '0';
+        if (i == 0 && id[0] >= 'X' && id[0] <= 'Z') {
+            digit = id[0] - 'X';
+        }
+        if (digit < 0 || digit > 9) {
+            return -1;
+        }
+        sum += digit * personId_weights[i];
+    }
+
+    return sum;
+}
+
+// Check if an id is a DNI or NIE with the right control letter
+bool personId_isValid(const char* id) {
+    int sum;
+
+    // Check input data (Pre-conditions)
+    assert(id != NULL);
+
+    if (strlen(id) != PERSON_ID_LENGTH) {
+        return false;
+    }
+    sum = personId_sum(id);
+
+    return sum >= 0 && personId_letters[sum % 23] == id[PERSON_ID_LENGTH - 1];
+}
+
+// Weighted sums of the ids of a block, one at a time
+static void personId_sumsScalar(const char* ids, int count, int* sums) {
+    int i;
+
+    for (i = 0; i < count; i++) {
+        sums[i] = personId_sum(ids + i * PERSON_ID_LENGTH);
+    }
+}
+
+#ifdef PERSON_ID_USE_SIMD
+// Weighted sums of the ids of a block, 2 per register and 8 per iteration. The 8 digits of each id are
+// loaded in 8 bytes, checked to be digits and multiplied by their weights in 16 bit lanes
+__attribute__((target("sse2")))
+static void personId_sumsSSE2(const char* ids, int count, int* sums) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weights = _mm_setr_epi16(14, 6, 19, 18, 11, 8, 10, 1);
+    const __m128i first = _mm_setr_epi8(-1, 0, 0, 0, 0, 0, 0, 0, -1, 0, 0, 0, 0, 0, 0, 0);
+    __m128i bytes, nie, digits, values, sums0, sums1, low, high;
+    const char* id;
+    int mask, i, j;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        for (j = 0; j < 8; j += 2) {
+            id = ids + (i + j) * PERSON_ID_LENGTH;
+            bytes = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*) id),
+                                       _mm_loadl_epi64((const __m128i*) (id + PERSON_ID_LENGTH)));
+
+            // The X, Y or Z of a NIE is the digit 0, 1 or 2
+            nie = _mm_and_si128(first, _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('X' - 1)),
+                                                     _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), bytes)));
+            bytes = _mm_sub_epi8(bytes, _mm_and_si128(nie, _mm_set1_epi8('X' - '0')));
+            digits = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('0' - 1)),
+                                   _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), bytes));
+            mask = _mm_movemask_epi8(digits);
+            values = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+
+            // madd adds pairs of products, leaving 4 partial sums per id. They are interleaved and added
+            sums0 = _mm_madd_epi16(_mm_unpacklo_epi8(values, zero), weights);
+            sums1 = _mm_madd_epi16(_mm_unpackhi_epi8(values, zero), weights);
+            low = _mm_add_epi32(_mm_unpacklo_epi32(sums0, sums1), _mm_unpackhi_epi32(sums0, sums1));
+            high = _mm_add_epi32(low, _mm_unpackhi_epi64(low, low));
+            _mm_storel_epi64((__m128i*) (sums + i + j), high);
+
+            if ((mask & 0x00ff) != 0x00ff) {
+                sums[i + j] = -1;
+            }
+            if ((mask & 0xff00) != 0xff00) {
+                sums[i + j + 1] = -1;
+            }
+        }
+    }
+    personId_sumsScalar(ids + i * PERSON_ID_LENGTH, count - i, sums + i);
+}
+
+// Weighted sums of the ids of a block, 4 per register and 8 per iteration. The products of each id are
+// added in pairs by maddubs and madd, and the last two partial sums by a 64 bit shift
+__attribute__((target("avx2")))
+static void personId_sumsAVX2(const char* ids, int count, int* sums) {
+    const __m256i weights = _mm256_setr_epi8(14, 6, 19, 18, 11, 8, 10, 1, 14, 6, 19, 18, 11, 8, 10, 1,
+                                             14, 6, 19, 18, 11, 8, 10, 1, 14, 6, 19, 18, 11, 8, 10, 1);
+    const __m256i first = _mm256_set1_epi64x(0xff);
+    const __m256i ones = _mm256_set1_epi16(1);
+    const __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    __m256i bytes, nie, digits, partial;
+    __m128i low, high;
+    const char* id;
+    unsigned int mask;
+    int i, j, k;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        for (j = 0; j < 8; j += 4) {
+            id = ids + (i + j) * PERSON_ID_LENGTH;
+            low = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*) id),
+                                     _mm_loadl_epi64((const __m128i*) (id + PERSON_ID_LENGTH)));
+            high = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*) (id + 2 * PERSON_ID_LENGTH)),
+                                      _mm_loadl_epi64((const __m128i*) (id + 3 * PERSON_ID_LENGTH)));
+            bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+
+            // The X, Y or Z of a NIE is the digit 0, 1 or 2
+            nie = _mm256_and_si256(first, _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8('X' - 1)),
+                                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), bytes)));
+            bytes = _mm256_sub_epi8(bytes, _mm256_and_si256(nie, _mm256_set1_epi8('X' - '0')));
+            digits = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8('0' - 1)),
+                                      _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), bytes));
+            mask = (unsigned int) _mm256_movemask_epi8(digits);
+
+            partial = _mm256_madd_epi16(_mm256_maddubs_epi16(_mm256_sub_epi8(bytes, _mm256_set1_epi8('0')), weights), ones);
+            partial = _mm256_add_epi32(partial, _mm256_srli_epi64(partial, 32));
+            _mm_storeu_si128((__m128i*) (sums + i + j),
+                             _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(partial, order)));
+
+            for (k = 0; k < 4; k++) {
+                if (((mask >> (8 * k)) & 0xff) != 0xff) {
+                    sums[i + j + k] = -1;
+                }
+            }
+        }
+    }
+    personId_sumsScalar(ids + i * PERSON_ID_LENGTH, count - i, sums + i);
+}
+#endif
+
+// Select the best kernel for this CPU on the first call
+static void personId_sumsInit(const char* ids, int count, int* sums);
+
+// Kernel in use. Several threads may select it at the same time, so it is accessed atomically
+static tPersonIdSums personId_sumsKernel = personId_sumsInit;
+#ifdef __GNUC__
+#define PERSON_ID_GET_SUMS() __atomic_load_n(&personId_sumsKernel, __ATOMIC_RELAXED)
+#define PERSON_ID_SET_SUMS(sums) __atomic_store_n(&personId_sumsKernel, (sums), __ATOMIC_RELAXED)
+#else
+#define PERSON_ID_GET_SUMS() personId_sumsKernel
+#define PERSON_ID_SET_SUMS(sums) (personId_sumsKernel = (sums))
+#endif
+
+// Select the best kernel for this CPU on the first call
+static void personId_sumsInit(const char* ids, int count, int* sums) {
+    tPersonIdSums kernel = personId_sumsScalar;
+
+#ifdef PERSON_ID_USE_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        kernel = personId_sumsAVX2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        kernel = personId_sumsSSE2;
+    }
+#endif
+    PERSON_ID_SET_SUMS(kernel);
+
+    kernel(ids, count, sums);
+}
+
+// Check the control letter of count ids of a block
+int personId_validateBlock(const char* ids, int count, bool* valid) {
+    int sums[PERSON_ID_BLOCK];
+    tPersonIdSums kernel;
+    int numValid = 0;
+    int i, j, n;
+
+    // Check input data (Pre-conditions)
+    assert(count == 0 || ids != NULL);
+    assert(count == 0 || valid != NULL);
+
+    for (i = 0; i < count; i += n) {
+        n = (count - i < PERSON_ID_BLOCK) ? count - i : PERSON_ID_BLOCK;
+        kernel = PERSON_ID_GET_SUMS();
+        kernel(ids + i * PERSON_ID_LENGTH, n, sums);
+        for (j = 0; j < n; j++) {
+            valid[i + j] = sums[j] >= 0 && personId_letters[sums[j] % 23] == ids[(i + j + 1) * PERSON_ID_LENGTH - 1];
+            numValid += valid[i + j];
+        }
+    }
+
+    return numValid;
+}
@@ -1,15 +1,31 @@
 #include <assert.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include "rental_incomes.h"
 
+// Number of bytes of the sort key of an element (landlord and year), sorted one byte per pass
+#define RENTAL_INCOME_KEY_BYTES 12
+
+// Key of an element, compared as unsigned integers, and its position before sorting
+typedef struct _tRentalIncomeSortItem {
+    tKey landlord;
+    uint32_t year;
+    int position;
+} tRentalIncomeSortItem;
+
 // Parse a rental income
-void rentalIncome_parse(tRentalIncome* data, tCSVEntry entry) {
+bool rentalIncome_parse(tRentalIncome* data, tCSVEntry entry) {
+    return rentalIncome_parse_ptr(data, &entry);
+}
+
+// Parse a rental income, taking the entry by pointer
+bool rentalIncome_parse_ptr(tRentalIncome* data, const tCSVEntry* entry) {
     assert(data != NULL);
-    assert(csv_numFields(entry) == NUM_FIELDS_RENTAL_INCOME);
+    assert(csv_numFields_ptr(entry) == NUM_FIELDS_RENTAL_INCOME);
     
-    data->year = csv_getAsInteger(entry, 0);
-    data->totalIncome = csv_getAsReal(entry, 1);
+    return csv_tryGetAsInteger_ptr(entry, 0, &(data->year)) &&
+           csv_tryGetAsCents_ptr(entry, 1, &(data->totalIncome)) && !csv_hasEmptyField(entry);
 }
 
 // Initialize a rental incomes list
@@ -17,11 +33,18 @@ void rentalIncomes_init(tRentalIncomeList *list) {
     // Check input data (Pre-conditions)
     assert(list != NULL);
     
+    list->root = NULL;
+    list->height = 0;
     list->first = NULL;
     list->count = 0;
+    list->bulkElems = NULL;
+    list->bulkKeys = NULL;
+    list->bulkCount = 0;
+    list->capacity = 0;
+    list->bulk = false;
 }
 
-// Check if the linked list is empty
+// Check if the list is empty
 bool rentalIncomes_isEmpty(tRentalIncomeList list) {
     return list.count == 0;
 }
@@ -31,50 +54,333 @@ int rentalIncomes_len(tRentalIncomeList list) {
     return list.count;
 }
 
-// Create and initialize a node of tRentalIncomeListNode
-tRentalIncomeListNode* rentalIncomes_createNode(tRentalIncome rentalIncome) {
-    tRentalIncomeListNode *pNode = NULL;
+// Find the leaf holding the element at the given position, leaving in index its position in the leaf
+static tRentalIncomeLeaf* rentalIncomes_leafAt(const tRentalIncomeList* list, int* index) {
+    const tRentalIncomeNode* node;
+    void* child = list->root;
+    int level, i;
     
-    pNode = (tRentalIncomeListNode*) malloc(sizeof(tRentalIncomeListNode));
-    assert(pNode != NULL);
+    for (level = list->height; level > 0; level--) {
+        node = (const tRentalIncomeNode*) child;
+        for (i = 0; *index >= node->sizes[i]; i++) {
+            *index -= node->sizes[i];
+        }
+        child = node->children[i];
+    }
     
-    pNode->elem.landlord = rentalIncome.landlord;
-    pNode->elem.year = rentalIncome.year;
-    pNode->elem.totalIncome = rentalIncome.totalIncome;
+    return (tRentalIncomeLeaf*) child;
+}
+
+// Get the element at the given position of the list
+tRentalIncome* rentalIncomes_get(tRentalIncomeList list, int index) {
+    return rentalIncomes_get_ptr(&list, index);
+}
+
+// Get the element at the given position, taking the list by pointer
+tRentalIncome* rentalIncomes_get_ptr(const tRentalIncomeList* list, int index) {
+    tRentalIncome* elems;
     
-    pNode->next = NULL;
+    // Check input data (Pre-conditions)
+    assert(list != NULL);
+    assert(index >= 0 && index < list->count);
+    
+    rentalIncomes_getRun(list, index, &elems, NULL);
     
-    return pNode;
+    return elems;
 }
 
-// Add an element into the linked list
-tApiError rentalIncomes_add(tRentalIncomeList *list, tRentalIncome rentalIncome) {
-    tRentalIncomeListNode *pNode = NULL, *pCurrent = NULL, *pPrev = NULL;
+// Get the elements stored one after the other from the given position
+int rentalIncomes_getRun(const tRentalIncomeList* list, int index, tRentalIncome** elems, const tRentalIncomeKey** keys) {
+    tRentalIncomeLeaf* leaf;
+    int treeCount;
     
     // Check input data (Pre-conditions)
     assert(list != NULL);
+    assert(elems != NULL);
+    assert(index >= 0 && index < list->count);
+    
+    // Elements added in bulk mode are kept apart, after the others, until the mode ends
+    treeCount = list->count - list->bulkCount;
+    if (index >= treeCount) {
+        *elems = &(list->bulkElems[index - treeCount]);
+        if (keys != NULL) {
+            *keys = &(list->bulkKeys[index - treeCount]);
+        }
+        return list->count - index;
+    }
+    
+    leaf = rentalIncomes_leafAt(list, &index);
+    *elems = &(leaf->elems[index]);
+    if (keys != NULL) {
+        *keys = &(leaf->keys[index]);
+    }
+    
+    return leaf->count - index;
+}
+
+// Compare a year and landlord id with the key of an element
+static int rentalIncomes_cmpKey(int year, tKey landlord, const tRentalIncomeKey* key) {
+    if (year != key->year) {
+        return (year < key->year) ? -1 : 1;
+    }
+    
+    return (landlord > key->landlord) - (landlord < key->landlord);
+}
+
+// Find the position of a leaf where the year and landlord id are or should be placed
+static int rentalIncomes_searchLeaf(const tRentalIncomeLeaf* leaf, int year, tKey landlord, bool* found) {
+    int low = 0, high = leaf->count;
+    int middle, cmp;
     
-    pNode = rentalIncomes_createNode(rentalIncome);
+    *found = false;
     
-    if (pNode == NULL) {
-        return E_MEMORY_ERROR;
+    // Elements are usually added in order, so check the end first
+    if (high > 0 && rentalIncomes_cmpKey(year, landlord, &(leaf->keys[high - 1])) > 0) {
+        return high;
     }
     
-    pCurrent = list->first;
-    pPrev = NULL;
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        cmp = rentalIncomes_cmpKey(year, landlord, &(leaf->keys[middle]));
+        if (cmp == 0) {
+            *found = true;
+            return middle;
+        } else if (cmp < 0) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
     
-    while (pCurrent != NULL && (pCurrent->elem.year < rentalIncome.year ||
-           (pCurrent->elem.year == rentalIncome.year && strcmp(pCurrent->elem.landlord->id, rentalIncome.landlord->id) < 0))) {
-        pPrev = pCurrent;
-        pCurrent = pCurrent->next;
+    return low;
+}
+
+// Find the child of an inner node where the year and landlord id are or should be placed: the last one
+// whose smallest key is not greater, or the first one
+static int rentalIncomes_searchNode(const tRentalIncomeNode* node, int year, tKey landlord) {
+    int low = 1, high = node->count;
+    int middle;
+    
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (rentalIncomes_cmpKey(year, landlord, &(node->keys[middle])) < 0) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
     }
+    
+    return low - 1;
+}
 
-    if (pPrev == NULL) {
-        pNode->next = list->first;
-        list->first = pNode;
+// Find the leaf where the year and landlord id are or should be placed, and the position of its first element
+static tRentalIncomeLeaf* rentalIncomes_search(const tRentalIncomeList* list, int year, tKey landlord, int* offset) {
+    const tRentalIncomeNode* node;
+    void* child = list->root;
+    int level, pos, i;
+    
+    *offset = 0;
+    for (level = list->height; level > 0; level--) {
+        node = (const tRentalIncomeNode*) child;
+        pos = rentalIncomes_searchNode(node, year, landlord);
+        for (i = 0; i < pos; i++) {
+            *offset += node->sizes[i];
+        }
+        child = node->children[pos];
+    }
+    
+    return (tRentalIncomeLeaf*) child;
+}
+
+// Number of elements under a node of the given level
+static int rentalIncomes_size(const void* node, int level) {
+    const tRentalIncomeNode* inner;
+    int size = 0;
+    int i;
+    
+    if (level == 0) {
+        return ((const tRentalIncomeLeaf*) node)->count;
+    }
+    
+    inner = (const tRentalIncomeNode*) node;
+    for (i = 0; i < inner->count; i++) {
+        size += inner->sizes[i];
+    }
+    
+    return size;
+}
+
+// Smallest key under a node of the given level
+static const tRentalIncomeKey* rentalIncomes_minKey(const void* node, int level) {
+    return (level == 0) ? &(((const tRentalIncomeLeaf*) node)->keys[0]) : &(((const tRentalIncomeNode*) node)->keys[0]);
+}
+
+// Insert an element into a leaf with room for it
+static void rentalIncomes_insertLeaf(tRentalIncomeLeaf* leaf, int pos, const tRentalIncomeKey* key, const tRentalIncome* elem) {
+    assert(leaf->count < RENTAL_INCOME_LEAF_SIZE);
+    
+    memmove(&(leaf->elems[pos + 1]), &(leaf->elems[pos]), (leaf->count - pos) * sizeof(tRentalIncome));
+    memmove(&(leaf->keys[pos + 1]), &(leaf->keys[pos]), (leaf->count - pos) * sizeof(tRentalIncomeKey));
+    leaf->elems[pos] = *elem;
+    leaf->keys[pos] = *key;
+    leaf->count++;
+}
+
+// Insert a child into an inner node with room for it
+static void rentalIncomes_insertNode(tRentalIncomeNode* node, int pos, const tRentalIncomeKey* key, void* child, int size) {
+    assert(node->count < RENTAL_INCOME_NODE_SIZE);
+    
+    memmove(&(node->keys[pos + 1]), &(node->keys[pos]), (node->count - pos) * sizeof(tRentalIncomeKey));
+    memmove(&(node->sizes[pos + 1]), &(node->sizes[pos]), (node->count - pos) * sizeof(int));
+    memmove(&(node->children[pos + 1]), &(node->children[pos]), (node->count - pos) * sizeof(void*));
+    node->keys[pos] = *key;
+    node->sizes[pos] = size;
+    node->children[pos] = child;
+    node->count++;
+}
+
+// Insert an element under a node of the given level. If the node is full it is split, and the new node,
+// which goes right after it, is returned in split. A node full after an insertion at its end keeps all
+// its elements, so elements added in order leave full nodes behind
+static tApiError rentalIncomes_insert(void* node, int level, const tRentalIncomeKey* key, const tRentalIncome* elem, void** split) {
+    tRentalIncomeLeaf *leaf, *newLeaf;
+    tRentalIncomeNode *inner, *newInner;
+    void* newChild;
+    tApiError error;
+    bool found;
+    int pos, at;
+    
+    *split = NULL;
+    
+    if (level == 0) {
+        leaf = (tRentalIncomeLeaf*) node;
+        pos = rentalIncomes_searchLeaf(leaf, key->year, key->landlord, &found);
+        if (found) {
+            return E_RENTAL_INCOME_DUPLICATED;
+        }
+        if (leaf->count < RENTAL_INCOME_LEAF_SIZE) {
+            rentalIncomes_insertLeaf(leaf, pos, key, elem);
+            return E_SUCCESS;
+        }
+        
+        newLeaf = (tRentalIncomeLeaf*) malloc(sizeof(tRentalIncomeLeaf));
+        assert(newLeaf != NULL);
+        at = (pos == RENTAL_INCOME_LEAF_SIZE) ? pos : RENTAL_INCOME_LEAF_SIZE / 2;
+        newLeaf->count = RENTAL_INCOME_LEAF_SIZE - at;
+        memcpy(newLeaf->elems, &(leaf->elems[at]), newLeaf->count * sizeof(tRentalIncome));
+        memcpy(newLeaf->keys, &(leaf->keys[at]), newLeaf->count * sizeof(tRentalIncomeKey));
+        leaf->count = at;
+        newLeaf->next = leaf->next;
+        leaf->next = newLeaf;
+        
+        if (pos <= at && at < RENTAL_INCOME_LEAF_SIZE) {
+            rentalIncomes_insertLeaf(leaf, pos, key, elem);
+        } else {
+            rentalIncomes_insertLeaf(newLeaf, pos - at, key, elem);
+        }
+        *split = newLeaf;
+        
+        return E_SUCCESS;
+    }
+    
+    inner = (tRentalIncomeNode*) node;
+    pos = rentalIncomes_searchNode(inner, key->year, key->landlord);
+    error = rentalIncomes_insert(inner->children[pos], level - 1, key, elem, &newChild);
+    if (error != E_SUCCESS) {
+        return error;
+    }
+    
+    // Only the first child can get a key smaller than its own
+    if (rentalIncomes_cmpKey(key->year, key->landlord, &(inner->keys[pos])) < 0) {
+        inner->keys[pos] = *key;
+    }
+    if (newChild == NULL) {
+        inner->sizes[pos]++;
+        return E_SUCCESS;
+    }
+    inner->sizes[pos] = rentalIncomes_size(inner->children[pos], level - 1);
+    pos++;
+    
+    if (inner->count < RENTAL_INCOME_NODE_SIZE) {
+        rentalIncomes_insertNode(inner, pos, rentalIncomes_minKey(newChild, level - 1), newChild,
+                                 rentalIncomes_size(newChild, level - 1));
+        return E_SUCCESS;
+    }
+    
+    newInner = (tRentalIncomeNode*) malloc(sizeof(tRentalIncomeNode));
+    assert(newInner != NULL);
+    at = (pos == RENTAL_INCOME_NODE_SIZE) ? pos : RENTAL_INCOME_NODE_SIZE / 2;
+    newInner->count = RENTAL_INCOME_NODE_SIZE - at;
+    memcpy(newInner->keys, &(inner->keys[at]), newInner->count * sizeof(tRentalIncomeKey));
+    memcpy(newInner->sizes, &(inner->sizes[at]), newInner->count * sizeof(int));
+    memcpy(newInner->children, &(inner->children[at]), newInner->count * sizeof(void*));
+    inner->count = at;
+    
+    if (pos <= at && at < RENTAL_INCOME_NODE_SIZE) {
+        rentalIncomes_insertNode(inner, pos, rentalIncomes_minKey(newChild, level - 1), newChild,
+                                 rentalIncomes_size(newChild, level - 1));
     } else {
-        pPrev->next = pNode;
-        pNode->next = pCurrent;
+        rentalIncomes_insertNode(newInner, pos - at, rentalIncomes_minKey(newChild, level - 1), newChild,
+                                 rentalIncomes_size(newChild, level - 1));
+    }
+    *split = newInner;
+    
+    return E_SUCCESS;
+}
+
+// Add an element into the list
+tApiError rentalIncomes_add(tRentalIncomeList *list, tRentalIncome rentalIncome) {
+    tRentalIncomeLeaf* leaf;
+    tRentalIncomeNode* root;
+    tRentalIncomeKey key;
+    tApiError error;
+    void* split;
+    
+    // Check input data (Pre-conditions)
+    assert(list != NULL);
+    assert(rentalIncome.landlord != NULL);
+    key.year = rentalIncome.year;
+    key.landlord = key_pack(rentalIncome.landlord->id);
+    assert(key.landlord != KEY_INVALID);
+    
+    // In bulk mode, just append
+    if (list->bulk) {
+        if (list->bulkCount == list->capacity) {
+            rentalIncomes_reserve(list, (list->capacity == 0) ? 16 : list->capacity * 2);
+        }
+        list->bulkElems[list->bulkCount] = rentalIncome;
+        list->bulkKeys[list->bulkCount] = key;
+        list->bulkCount++;
+        list->count++;
+        return E_SUCCESS;
+    }
+    
+    if (list->root == NULL) {
+        leaf = (tRentalIncomeLeaf*) malloc(sizeof(tRentalIncomeLeaf));
+        assert(leaf != NULL);
+        leaf->count = 0;
+        leaf->next = NULL;
+        list->root = leaf;
+        list->first = leaf;
+        list->height = 0;
+    }
+    
+    error = rentalIncomes_insert(list->root, list->height, &key, &rentalIncome, &split);
+    if (error != E_SUCCESS) {
+        return error;
+    }
+    
+    // A split root gets a new root above it
+    if (split != NULL) {
+        root = (tRentalIncomeNode*) malloc(sizeof(tRentalIncomeNode));
+        assert(root != NULL);
+        root->count = 0;
+        rentalIncomes_insertNode(root, 0, rentalIncomes_minKey(list->root, list->height), list->root,
+                                 rentalIncomes_size(list->root, list->height));
+        rentalIncomes_insertNode(root, 1, rentalIncomes_minKey(split, list->height), split,
+                                 rentalIncomes_size(split, list->height));
+        list->root = root;
+        list->height++;
     }
     
     list->count++;
@@ -82,19 +388,267 @@ tApiError rentalIncomes_add(tRentalIncomeList *list, tRentalIncome rentalIncome)
     return E_SUCCESS;
 }
 
-// Release the list
-void rentalIncomes_free(tRentalIncomeList *list) {
-    tRentalIncomeListNode *pNode = NULL, *pAux = NULL;
+// Find the position of the element with the given year and landlord id
+int rentalIncomes_position(tRentalIncomeList list, int year, const char* landlord_id) {
+    return rentalIncomes_position_ptr(&list, year, landlord_id);
+}
+
+// Find the position of the element with the given year and landlord id, taking the list by pointer
+int rentalIncomes_position_ptr(const tRentalIncomeList* list, int year, const char* landlord_id) {
+    const tRentalIncomeLeaf* leaf;
+    tKey landlord;
+    bool found;
+    int offset, pos;
+    
+    // Check input data (Pre-conditions)
+    assert(list != NULL);
+    assert(landlord_id != NULL);
+    assert(!list->bulk);
+    
+    if (list->root == NULL) {
+        return -1;
+    }
+    
+    landlord = key_pack(landlord_id);
+    leaf = rentalIncomes_search(list, year, landlord, &offset);
+    pos = rentalIncomes_searchLeaf(leaf, year, landlord, &found);
+    
+    return found ? offset + pos : -1;
+}
+
+// Get the sum of the total income of all the elements
+tMoney rentalIncomes_total(const tRentalIncomeList* list) {
+    tMoney incomes[MONEY_BATCH_SIZE];
+    tRentalIncome* elems;
+    tMoney total = 0;
+    int i, j, k, n, run;
+
+    // Check input data (Pre-conditions)
+    assert(list != NULL);
+
+    // Gather the incomes of each run in batches, so they are summed from contiguous memory
+    for (i = 0; i < list->count; i += run) {
+        run = rentalIncomes_getRun(list, i, &elems, NULL);
+        for (j = 0; j < run; j += n) {
+            n = (run - j < MONEY_BATCH_SIZE) ? run - j : MONEY_BATCH_SIZE;
+            for (k = 0; k < n; k++) {
+                incomes[k] = elems[j + k].totalIncome;
+            }
+            total += money_sum(incomes, n);
+        }
+    }
+
+    return total;
+}
+
+// Make room for at least capacity elements added in bulk mode
+void rentalIncomes_reserve(tRentalIncomeList *list, int capacity) {
+    // Check input data (Pre-conditions)
+    assert(list != NULL);
+    
+    if (capacity > list->capacity) {
+        list->bulkElems = (tRentalIncome*) realloc(list->bulkElems, capacity * sizeof(tRentalIncome));
+        list->bulkKeys = (tRentalIncomeKey*) realloc(list->bulkKeys, capacity * sizeof(tRentalIncomeKey));
+        assert(list->bulkElems != NULL);
+        assert(list->bulkKeys != NULL);
+        list->capacity = capacity;
+    }
+}
+
+// Start adding elements in bulk mode
+void rentalIncomes_beginBulk(tRentalIncomeList *list) {
+    // Check input data (Pre-conditions)
+    assert(list != NULL);
+    
+    list->bulk = true;
+}
+
+// Get a byte of the sort key of an item, from the lowest byte of the landlord to the highest of the year
+static unsigned int rentalIncomes_keyByte(const tRentalIncomeSortItem* item, int pass) {
+    return (pass < 8) ? (item->landlord >> (8 * pass)) & 0xff : (item->year >> (8 * (pass - 8))) & 0xff;
+}
+
+// Sort the items by year and landlord with a stable LSD radix sort, one byte per pass. Passes where 
+// all the items have the same byte are skipped
+static void rentalIncomes_radixSort(tRentalIncomeSortItem* items, tRentalIncomeSortItem* buffer, int count) {
+    tRentalIncomeSortItem *src = items, *dst = buffer, *aux;
+    int counts[256];
+    int pass, i, digit, total, n;
+    
+    for (pass = 0; pass < RENTAL_INCOME_KEY_BYTES; pass++) {
+        memset(counts, 0, sizeof(counts));
+        for (i = 0; i < count; i++) {
+            counts[rentalIncomes_keyByte(&(src[i]), pass)]++;
+        }
+        if (counts[rentalIncomes_keyByte(&(src[0]), pass)] == count) {
+            continue;
+        }
+        
+        // Start position of each digit
+        total = 0;
+        for (digit = 0; digit < 256; digit++) {
+            n = counts[digit];
+            counts[digit] = total;
+            total += n;
+        }
+        for (i = 0; i < count; i++) {
+            dst[counts[rentalIncomes_keyByte(&(src[i]), pass)]++] = src[i];
+        }
+        aux = src;
+        src = dst;
+        dst = aux;
+    }
+    
+    if (src != items) {
+        memcpy(items, src, count * sizeof(tRentalIncomeSortItem));
+    }
+}
+
+// Release a node of the given level and all the nodes under it
+static void rentalIncomes_freeNode(void* node, int level) {
+    tRentalIncomeNode* inner;
+    int i;
+    
+    if (level > 0) {
+        inner = (tRentalIncomeNode*) node;
+        for (i = 0; i < inner->count; i++) {
+            rentalIncomes_freeNode(inner->children[i], level - 1);
+        }
+    }
+    free(node);
+}
+
+// Build the tree bottom up from sorted elements, with full leaves and inner nodes
+static void rentalIncomes_build(tRentalIncomeList *list, const tRentalIncome* elems, const tRentalIncomeKey* keys, int count) {
+    tRentalIncomeLeaf *leaf, *last = NULL;
+    tRentalIncomeNode* inner;
+    void** nodes;
+    int numNodes, level, i, j;
+    
+    numNodes = (count + RENTAL_INCOME_LEAF_SIZE - 1) / RENTAL_INCOME_LEAF_SIZE;
+    nodes = (void**) malloc(numNodes * sizeof(void*));
+    assert(nodes != NULL);
+    
+    for (i = 0; i < numNodes; i++) {
+        leaf = (tRentalIncomeLeaf*) malloc(sizeof(tRentalIncomeLeaf));
+        assert(leaf != NULL);
+        leaf->count = (count - i * RENTAL_INCOME_LEAF_SIZE < RENTAL_INCOME_LEAF_SIZE) ?
+                      count - i * RENTAL_INCOME_LEAF_SIZE : RENTAL_INCOME_LEAF_SIZE;
+        memcpy(leaf->elems, &(elems[i * RENTAL_INCOME_LEAF_SIZE]), leaf->count * sizeof(tRentalIncome));
+        memcpy(leaf->keys, &(keys[i * RENTAL_INCOME_LEAF_SIZE]), leaf->count * sizeof(tRentalIncomeKey));
+        leaf->next = NULL;
+        if (last != NULL) {
+            last->next = leaf;
+        }
+        last = leaf;
+        nodes[i] = leaf;
+    }
+    list->first = (tRentalIncomeLeaf*) nodes[0];
+    
+    // Each level groups the nodes of the one below, in place
+    for (level = 0; numNodes > 1; level++) {
+        for (i = 0; i * RENTAL_INCOME_NODE_SIZE < numNodes; i++) {
+            inner = (tRentalIncomeNode*) malloc(sizeof(tRentalIncomeNode));
+            assert(inner != NULL);
+            inner->count = 0;
+            for (j = i * RENTAL_INCOME_NODE_SIZE; j < numNodes && j < (i + 1) * RENTAL_INCOME_NODE_SIZE; j++) {
+                rentalIncomes_insertNode(inner, inner->count, rentalIncomes_minKey(nodes[j], level), nodes[j],
+                                         rentalIncomes_size(nodes[j], level));
+            }
+            nodes[i] = inner;
+        }
+        numNodes = i;
+    }
+    
+    list->root = nodes[0];
+    list->height = level;
+    free(nodes);
+}
+
+// Sort the elements added in bulk mode, merge them with the rest and end the mode
+tApiError rentalIncomes_endBulk(tRentalIncomeList *list) {
+    tApiError error = E_SUCCESS;
+    tRentalIncomeSortItem *items, *buffer;
+    tRentalIncome *all, *elems;
+    tRentalIncomeKey *allKeys, *keys;
+    const tRentalIncomeLeaf* leaf;
+    int i, count;
     
     // Check input data (Pre-conditions)
     assert(list != NULL);
     
-    pNode = list->first;
+    list->bulk = false;
+    if (list->bulkCount == 0) {
+        return E_SUCCESS;
+    }
     
-    while (pNode != NULL) {
-        pAux = pNode->next;
-        free(pNode);
-        pNode = pAux;
+    items = (tRentalIncomeSortItem*) malloc(list->count * sizeof(tRentalIncomeSortItem));
+    buffer = (tRentalIncomeSortItem*) malloc(list->count * sizeof(tRentalIncomeSortItem));
+    all = (tRentalIncome*) malloc(list->count * sizeof(tRentalIncome));
+    allKeys = (tRentalIncomeKey*) malloc(list->count * sizeof(tRentalIncomeKey));
+    elems = (tRentalIncome*) malloc(list->count * sizeof(tRentalIncome));
+    keys = (tRentalIncomeKey*) malloc(list->count * sizeof(tRentalIncomeKey));
+    assert(items != NULL && buffer != NULL && all != NULL && allKeys != NULL && elems != NULL && keys != NULL);
+    
+    // The elements already in the list go first, so they are kept over the new ones with the same key
+    count = 0;
+    for (leaf = list->first; leaf != NULL; leaf = leaf->next) {
+        memcpy(&(all[count]), leaf->elems, leaf->count * sizeof(tRentalIncome));
+        memcpy(&(allKeys[count]), leaf->keys, leaf->count * sizeof(tRentalIncomeKey));
+        count += leaf->count;
+    }
+    memcpy(&(all[count]), list->bulkElems, list->bulkCount * sizeof(tRentalIncome));
+    memcpy(&(allKeys[count]), list->bulkKeys, list->bulkCount * sizeof(tRentalIncomeKey));
+    assert(count + list->bulkCount == list->count);
+    
+    for (i = 0; i < list->count; i++) {
+        // The year is biased so negative years go first
+        items[i].landlord = allKeys[i].landlord;
+        items[i].year = (uint32_t) allKeys[i].year ^ 0x80000000u;
+        items[i].position = i;
+    }
+    rentalIncomes_radixSort(items, buffer, list->count);
+    
+    // Place the elements in order. The sort is stable, so the first of equal keys is the oldest one
+    count = 0;
+    for (i = 0; i < list->count; i++) {
+        if (i > 0 && items[i].landlord == items[i - 1].landlord && items[i].year == items[i - 1].year) {
+            error = E_RENTAL_INCOME_DUPLICATED;
+            continue;
+        }
+        elems[count] = all[items[i].position];
+        keys[count] = allKeys[items[i].position];
+        count++;
+    }
+    
+    // Rebuild the list, releasing the arrays of the bulk mode
+    rentalIncomes_free(list);
+    rentalIncomes_build(list, elems, keys, count);
+    list->count = count;
+    
+    free(items);
+    free(buffer);
+    free(all);
+    free(allKeys);
+    free(elems);
+    free(keys);
+    
+    return error;
+}
+
+// Release the list
+void rentalIncomes_free(tRentalIncomeList *list) {
+    // Check input data (Pre-conditions)
+    assert(list != NULL);
+    
+    if (list->root != NULL) {
+        rentalIncomes_freeNode(list->root, list->height);
+    }
+    if (list->bulkElems != NULL) {
+        free(list->bulkElems);
+    }
+    if (list->bulkKeys != NULL) {
+        free(list->bulkKeys);
     }
     
     rentalIncomes_init(list);
@@ -3,6 +3,9 @@
 #include <assert.h>
 #include "tenant.h"
 
+// Initial number of tenants of the data
+#define TENANTS_INITIAL_CAPACITY 16
+
 // Initialize a tenant
 void tenant_init(tTenant *tenant) {
     // Check input data (Pre-conditions)
@@ -17,7 +20,7 @@ void tenant_init(tTenant *tenant) {
     tenant->end_date.year = -1;
     
     tenant->name = NULL;
-    tenant->rent = -1.0;
+    tenant->rent = -MONEY_CENTS;
     tenant->age = - 1;
 }
 
@@ -54,36 +57,49 @@ void tenant_cpy(tTenant *dst, tTenant src) {
 }
 
 // Parse input from CSVEntry
-void tenant_parse(tTenant* data, tCSVEntry entry) {
+bool tenant_parse(tTenant* data, tCSVEntry entry) {
+    return tenant_parse_ptr(data, &entry);
+}
+
+// Parse input from CSVEntry, taking the entry by pointer
+bool tenant_parse_ptr(tTenant* data, const tCSVEntry* entry) {
+    bool valid;
     char start_date[11];
     char end_date[11];
     
     // Check input data (Pre-conditions)
     assert(data != NULL);    
-    assert(csv_numFields(entry) == NUM_FIELDS_TENANT);
+    assert(csv_numFields_ptr(entry) == NUM_FIELDS_TENANT);
     
     // Initialize the tentant
     tenant_init(data);
     
     // Get the date and time
-    csv_getAsString(entry, 0, start_date, 11);    
+    csv_getAsString_ptr(entry, 0, start_date, 11);    
     date_parse(&(data->start_date), start_date);
 
-    csv_getAsString(entry, 1, end_date, 11);    
+    csv_getAsString_ptr(entry, 1, end_date, 11);    
     date_parse(&(data->end_date), end_date);
     
     // Assign the tenant ID
-    csv_getAsString(entry, 2, data->tenant_id, MAX_PERSON_ID + 1);
+    csv_getAsString_ptr(entry, 2, data->tenant_id, MAX_PERSON_ID + 1);
 
     // Assign the tenant name
-    data->name = (char*) malloc((strlen(entry.fields[3]) + 1) * sizeof(char));
+    data->name = (char*) malloc((csv_getFieldLength_ptr(entry, 3) + 1) * sizeof(char));
     assert(data->name != NULL);
-    memset(data->name, 0, (strlen(entry.fields[3]) + 1) * sizeof(char));
-    csv_getAsString(entry, 3, data->name, strlen(entry.fields[3]) + 1);
+    memset(data->name, 0, (csv_getFieldLength_ptr(entry, 3) + 1) * sizeof(char));
+    csv_getAsString_ptr(entry, 3, data->name, csv_getFieldLength_ptr(entry, 3) + 1);
+    
+    valid = csv_tryGetAsCents_ptr(entry, 4, &(data->rent));
+    valid = csv_tryGetAsInteger_ptr(entry, 5, &(data->age)) && valid;
+    csv_getAsString_ptr(entry, 6, data->cadastral_ref, MAX_CADASTRAL_REF + 1);
     
-    data->rent = csv_getAsInteger(entry, 4);
-    data->age = csv_getAsInteger(entry, 5);
-    csv_getAsString(entry, 6, data->cadastral_ref, MAX_CADASTRAL_REF + 1);
+    // All the fields are required, and ids are packed in keys to index them
+    valid = valid && !csv_hasEmptyField(entry) && key_pack(data->tenant_id) != KEY_INVALID;
+    // The id must be a DNI or NIE with the right control letter
+    valid = valid && personId_isValid(data->tenant_id);
+    
+    return valid;
 }
 
 // Release a tenant
@@ -105,6 +121,8 @@ void tenantData_init(tTenantData *data) {
     
     data->elems = NULL;
     data->count = 0;
+    data->capacity = 0;
+    hashIndex_init(&(data->index));
 }
 
 // Return the number of tenants
@@ -113,48 +131,128 @@ int tenantData_len(tTenantData tenants) {
 }
 
 // Add a tenant to the data
+// Allocate memory for a new element. The capacity is doubled, so adding n elements copies O(n) elements
+static void tenantData_grow(tTenantData *data) {
+    if (data->count == data->capacity) {
+        tenantData_reserve(data, (data->capacity == 0) ? TENANTS_INITIAL_CAPACITY : data->capacity * 2);
+    }
+}
+
 void tenantData_add(tTenantData *data, tTenant tenant) {
+    tKey key;
+    
     // Check input data (Pre-conditions)
     assert(data != NULL);
     
-    // If tenant does not exist, add it
-    if (tenantData_find(*(data), tenant.tenant_id) < 0) {
+    // If tenant does not exist and its id can be indexed, add it
+    key = key_pack(tenant.tenant_id);
+    if (key != KEY_INVALID && hashIndex_find(&(data->index), key) == NULL) {
         // Allocate memory for new element
-        if (data->count == 0) {
-            // Request new memory space
-            data->elems = (tTenant*) malloc(sizeof(tTenant));
-        } else {
-            // Modify currently allocated memory
-            data->elems = (tTenant*) realloc(data->elems, sizeof(tTenant) * (data->count + 1));
-        }
-        
-        assert(data->elems != NULL);
+        tenantData_grow(data);
     
         // Initialize the new element
         tenant_init(&(data->elems[data->count]));
         
         // Copy the element to the position
         tenant_cpy(&(data->elems[data->count]), tenant);
+        hashIndex_add(&(data->index), key, data->count, -1);
         
         // Increase the number of elements
         data->count++;
     }
 }
 
+// Add a tenant to the data, taking the ownership of its memory
+bool tenantData_add_move(tTenantData *data, tTenant *tenant) {
+    tKey key;
+    
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    assert(tenant != NULL);
+    
+    // The index rejects existing tenants
+    key = key_pack(tenant->tenant_id);
+    if (key == KEY_INVALID || !hashIndex_add(&(data->index), key, data->count, -1)) {
+        return false;
+    }
+    
+    // Move the element to the new position, leaving the source without memory
+    tenantData_grow(data);
+    data->elems[data->count] = *tenant;
+    tenant->name = NULL;
+    
+    // Increase the number of elements
+    data->count++;
+    
+    return true;
+}
+
 // Return the position of the tenant if it exists, otherwise, it returns -1
 int tenantData_find(tTenantData data, const char* tenant_id) {
-    int i;
+    return tenantData_find_ptr(&data, tenant_id);
+}
+
+// Return the position of the tenant if it exists, otherwise, it returns -1
+int tenantData_find_ptr(const tTenantData* data, const char* tenant_id) {
+    tHashSlot* slot;
     
     // Check input data (Pre-conditions)
+    assert(data != NULL);
     assert(tenant_id != NULL);
     
-    for (i = 0; i < data.count; i++) {
-        if (strcmp(data.elems[i].tenant_id, tenant_id) == 0) {
-            return i;
+    slot = hashIndex_find(&(data->index), key_pack(tenant_id));
+    
+    return (slot != NULL) ? slot->position : -1;
+}
+
+// Build again the index of the tenants by id from the elements
+bool tenantData_reindex(tTenantData *data) {
+    tKey key;
+    bool valid = true;
+    int i;
+    
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    
+    hashIndex_clear(&(data->index));
+    for (i = 0; i < data->count; i++) {
+        key = key_pack(data->elems[i].tenant_id);
+        if (key != KEY_INVALID) {
+            hashIndex_add(&(data->index), key, i, -1);
+        } else {
+            valid = false;
         }
     }
     
-    return -1;
+    return valid;
+}
+
+// Make room for at least capacity tenants
+void tenantData_reserve(tTenantData *data, int capacity) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    
+    if (capacity > data->capacity) {
+        data->elems = (tTenant*) realloc(data->elems, sizeof(tTenant) * capacity);
+        assert(data->elems != NULL);
+        data->capacity = capacity;
+        hashIndex_reserve(&(data->index), capacity);
+    }
+}
+
+// Release the memory reserved for tenants that have not been added
+void tenantData_shrink(tTenantData *data) {
+    // Check input data (Pre-conditions)
+    assert(data != NULL);
+    
+    if (data->count == 0) {
+        free(data->elems);
+        data->elems = NULL;
+    } else if (data->count < data->capacity) {
+        data->elems = (tTenant*) realloc(data->elems, sizeof(tTenant) * data->count);
+        assert(data->elems != NULL);
+    }
+    data->capacity = data->count;
 }
 
 // Release the tenants data
@@ -166,6 +264,7 @@ void tenantData_free(tTenantData *data) {
     if (data->elems != NULL) {
         free(data->elems);
     }
+    hashIndex_free(&(data->index));
     
     // Initialize the structure again
     tenantData_init(data);
@@ -0,0 +1,34 @@
+#ifndef __TEST_CSV_H__
+#define __TEST_CSV_H__
+
+#include <stdbool.h>
+#include "test_suite.h"
+
+// Run all tests for the CSV library
+bool run_csv(tTestSuite* test_suite, const char* input);
+
+// Run tests for CSV entries
+bool run_csv_entries(tTestSection* test_section, const char* input);
+
+// Run tests for CSV readers
+bool run_csv_reader(tTestSection* test_section, const char* input);
+
+// Run tests for data snapshots
+bool run_csv_snapshot(tTestSection* test_section, const char* input);
+
+// Run tests for CSV writers
+bool run_csv_writer(tTestSection* test_section, const char* input);
+
+// Run tests for the indexes of the data
+bool run_csv_index(tTestSection* test_section, const char* input);
+
+// Run tests for the validation of person ids
+bool run_person_id(tTestSection* test_section, const char* input);
+
+// Run tests for amounts of money
+bool run_money(tTestSection* test_section, const char* input);
+
+// Run tests for the taxes of the landlords
+bool run_landlord(tTestSection* test_section, const char* input);
+
+#endif // __TEST_CSV_H__
@@ -2,16 +2,16 @@
 #define __TEST_DATA__H
 
 // Define test data for PR1
-const char* test_data_pr1_str = "TENANT;01/01/2023;31/12/2023;12345678A;Lucas;600.0;25;ABC1234\n" \
-								"TENANT;01/01/2024;31/12/2024;87654321B;Jason;750.0;30;ZYX1234\n" \
-								"TENANT;01/06/2024;31/08/2024;98765432J;Mary;888.25;32;QWE1234\n" \
-								"LANDLORD;John;87654321K;1200.0\n" \
+const char* test_data_pr1_str = "TENANT;01/01/2023;31/12/2023;12345678Z;Lucas;600.0;25;ABC1234\n" \
+								"TENANT;01/01/2024;31/12/2024;87654320D;Jason;750.0;30;ZYX1234\n" \
+								"TENANT;01/06/2024;31/08/2024;98765432M;Mary;888.25;32;QWE1234\n" \
+								"LANDLORD;John;87654321X;1200.0\n" \
 								"LANDLORD;William;54927077H;1500.0\n" \
-								"PROPERTY;ABC1234;Balmes;25;87654321K\n" \
-								"PROPERTY;ZYX1234;Balmes;26;87654321K\n" \
+								"PROPERTY;ABC1234;Balmes;25;87654321X\n" \
+								"PROPERTY;ZYX1234;Balmes;26;87654321X\n" \
 								"PROPERTY;QWE1234;Turing;99;54927077H\n" \
-								"RENTAL_INCOME;2023;3500.00;87654321K\n" \
-								"RENTAL_INCOME;2024;8800.55;87654321K\n" \
+								"RENTAL_INCOME;2023;3500.00;87654321X\n" \
+								"RENTAL_INCOME;2024;8800.55;87654321X\n" \
 								"RENTAL_INCOME;2024;7500.10;54927077H\n" \
 								"RENTAL_INCOME;2025;3500.99;54927077H\n";
                                                   
@@ -3,6 +3,7 @@
 #include "test_data.h"
 #include "test.h"
 #include "test_pr1.h"
+#include "test_csv.h"
 
 
 // Write data to file
@@ -42,4 +43,9 @@ void testSuite_run(tTestSuite* test_suite, const char* input, const char* readme
     }
     // Run tests
     run_pr1(test_suite, filename);
+    
+    //////////////////////
+    // Run tests for the CSV library
+    //////////////////////
+    run_csv(test_suite, filename);
 }
@@ -0,0 +1,1464 @@
+#include "test_csv.h"
+#include "api.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// Control letter of the DNI with the given number, so the ids of the records pass the validation
+static char validIdLetter(int number) {
+  return "TRWAGMYFPDXBNJZSQVHLCKE"[number % 23];
+}
+
+
+// Run all tests for the CSV library
+bool run_csv(tTestSuite *test_suite, const char *input) {
+    bool ok = true;
+    tTestSection* section = NULL;
+
+    assert(test_suite != NULL);
+
+    testSuite_addSection(test_suite, "CSV", "Tests for the CSV library");
+
+    section = testSuite_getSection(test_suite, "CSV");
+    assert(section != NULL);
+
+    ok = run_csv_entries(section, input);
+    ok = run_csv_reader(section, input) && ok;
+    ok = run_csv_snapshot(section, input) && ok;
+    ok = run_csv_writer(section, input) && ok;
+    ok = run_csv_index(section, input) && ok;
+    ok = run_person_id(section, input) && ok;
+    ok = run_money(section, input) && ok;
+    ok = run_landlord(section, input) && ok;
+
+    return ok;
+}
+
+// Run all tests for CSV entries
+bool run_csv_entries(tTestSection *test_section, const char *input) {
+  tCSVEntry entry;
+  tCSVEntry refEntry;
+  tCSVData data;
+  tCSVData refData;
+  tApiData apiData;
+  char buffer[16];
+  char line[512];
+  long long cents;
+  float real;
+  int value;
+  int len;
+  int i;
+  bool passed = true;
+  bool failed = false;
+
+  /////////////////////////////
+  /////  CSV ENTRY TEST 1  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_ENTRY_1", "Parse an entry as a view of the line");
+  csv_initEntry(&entry);
+  csv_initEntry(&refEntry);
+  csv_parseEntryView(&entry, "TENANT;01/01/2023;31/12/2023;12345678Z;Lucas;600.0;25;ABC1234\n", 61, NULL);
+  csv_parseEntry(&refEntry, "01/01/2023;31/12/2023;12345678Z;Lucas;600.0;25;ABC1234", "TENANT");
+  if (!csv_equalsEntry(entry, refEntry) || strcmp(csv_getType(&entry), "TENANT") != 0 || 
+      csv_numFields(entry) != 7 || csv_getFieldLength(entry, 3) != 5 || csv_getAsInteger(entry, 5) != 25) {
+    failed = true;
+    passed = false;
+  }
+  csv_getAsString(entry, 6, buffer, 4);
+  if (strcmp(buffer, "ABC") != 0) {
+    failed = true;
+    passed = false;
+  }
+  csv_freeEntry(&entry);
+  csv_freeEntry(&refEntry);
+  end_test(test_section, "CSV_ENTRY_1", !failed);
+
+  /////////////////////////////
+  /////  CSV ENTRY TEST 2  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_ENTRY_2", "Reuse a view entry for several lines");
+  csv_initEntry(&entry);
+  csv_parseEntryView(&entry, "LANDLORD;William;54927077H;1500.0", 33, NULL);
+  csv_parseEntryView(&entry, "PROPERTY;ABC1234;Balmes;25;87654321X", 36, NULL);
+  if (strcmp(csv_getType(&entry), "PROPERTY") != 0 || csv_numFields(entry) != 4 || 
+      csv_getAsInteger(entry, 2) != 25) {
+    failed = true;
+    passed = false;
+  }
+  csv_parseEntryView(&entry, "2024;3500.0;87654321X", 21, "RENTAL_INCOME");
+  if (strcmp(csv_getType(&entry), "RENTAL_INCOME") != 0 || csv_numFields(entry) != 3 || 
+      csv_getAsReal(entry, 1) != 3500.0) {
+    failed = true;
+    passed = false;
+  }
+  csv_freeEntry(&entry);
+  end_test(test_section, "CSV_ENTRY_2", !failed);
+
+  /////////////////////////////
+  /////  CSV ENTRY TEST 3  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_ENTRY_3", "Parse a long line with many fields");
+  memset(line, 0, sizeof(line));
+  strcpy(line, "NUMBERS");
+  for (i = 0; i < 100; i++) {
+    sprintf(line + strlen(line), ";%d", i * 7);
+  }
+  strcat(line, "\r\nNEXT;1");
+  csv_initEntry(&entry);
+  len = csv_parseEntryView(&entry, line, strlen(line), NULL);
+  if (len != strlen(line) - 7 || strcmp(csv_getType(&entry), "NUMBERS") != 0 || csv_numFields(entry) != 100) {
+    failed = true;
+    passed = false;
+  } else {
+    for (i = 0; i < 100; i++) {
+      if (csv_getAsInteger(entry, i) != i * 7) {
+        failed = true;
+        passed = false;
+      }
+    }
+  }
+  csv_freeEntry(&entry);
+  end_test(test_section, "CSV_ENTRY_3", !failed);
+
+  /////////////////////////////
+  /////  CSV ENTRY TEST 4  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_ENTRY_4", "Parse entries into an arena");
+  csv_initArena(&data);
+  csv_init(&refData);
+  for (i = 0; i < 5000; i++) {
+    sprintf(line, "%d;%d.5;%08dK", 2000 + i % 30, i, i);
+    csv_addStrEntry(&data, line, "RENTAL_INCOME");
+    csv_addStrEntry(&refData, line, "RENTAL_INCOME");
+  }
+  if (csv_numEntries(data) != 5000 || !csv_equals(data, refData) || 
+      csv_getAsReal(*csv_getEntry(data, 4999), 1) != 4999.5f) {
+    failed = true;
+    passed = false;
+  }
+  csv_free(&data);
+  csv_free(&refData);
+  if (csv_numEntries(data) != 0 || !data.useArena) {
+    failed = true;
+    passed = false;
+  }
+  end_test(test_section, "CSV_ENTRY_4", !failed);
+
+  /////////////////////////////
+  /////  CSV ENTRY TEST 5  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_ENTRY_5", "Parse numeric fields");
+  csv_initEntry(&entry);
+  csv_parseEntryView(&entry, "888.25;-42;3500;0.005;12a;;1.2.3;7.", 35, "NUMBERS");
+  if (!csv_tryGetAsReal(entry, 0, &real) || real != 888.25f || 
+      !csv_tryGetAsCents(entry, 0, &cents) || cents != 88825 ||
+      !csv_tryGetAsInteger(entry, 1, &value) || value != -42 ||
+      !csv_tryGetAsCents(entry, 2, &cents) || cents != 350000 ||
+      !csv_tryGetAsCents(entry, 3, &cents) || cents != 1 ||
+      csv_tryGetAsInteger(entry, 0, &value) || csv_tryGetAsInteger(entry, 4, &value) || 
+      csv_tryGetAsReal(entry, 5, &real) || csv_tryGetAsReal(entry, 6, &real) ||
+      !csv_tryGetAsReal(entry, 7, &real) || real != 7.0f) {
+    failed = true;
+    passed = false;
+  }
+  // Fields that are not valid numbers are 0, whatever the locale would make of them
+  if (csv_getAsInteger(entry, 4) != 0 || csv_getAsReal(entry, 6) != 0.0f || csv_getAsInteger(entry, 2) != 3500 ||
+      csv_tryGetAsInteger(entry, 4, &value) || value != 0 || csv_tryGetAsReal(entry, 6, &real) || real != 0.0f) {
+    failed = true;
+    passed = false;
+  }
+  // Amounts with too many digits to be stored as cents are not valid
+  if (csv_parseCents("999999999999999999", 18, &cents) || csv_parseCents("-99999999999999999.9", 20, &cents) ||
+      !csv_parseCents("9999999999999999.99", 19, &cents) || cents != 999999999999999999LL) {
+    failed = true;
+    passed = false;
+  }
+  csv_freeEntry(&entry);
+  end_test(test_section, "CSV_ENTRY_5", !failed);
+
+  /////////////////////////////
+  /////  CSV ENTRY TEST 6  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_ENTRY_6", "Recognise the type of the entries");
+  csv_initEntry(&entry);
+  csv_parseEntryView(&entry, "TENANT;01/01/2024;31/12/2024;12345678Z;900.0;1;Tenant", 53, NULL);
+  if (csv_getTypeId(&entry) != CSV_TYPE_TENANT || strcmp(csv_getType(&entry), "TENANT") != 0) {
+    failed = true;
+    passed = false;
+  }
+  csv_parseEntryView(&entry, "John;87654321X;1200.0", 21, "LANDLORD");
+  if (csv_getTypeId(&entry) != CSV_TYPE_LANDLORD || csv_numFields(entry) != 3) {
+    failed = true;
+    passed = false;
+  }
+  csv_parseEntryView(&entry, "RENTAL_INCOMES;2024;87654321X", 29, NULL);
+  if (csv_getTypeId(&entry) != CSV_TYPE_UNKNOWN || strcmp(csv_getType(&entry), "RENTAL_INCOMES") != 0) {
+    failed = true;
+    passed = false;
+  }
+  csv_freeEntry(&entry);
+  csv_initEntry(&entry);
+  csv_parseEntry(&entry, "2024;87654321X", "RENTAL_INCOME");
+  if (csv_getTypeId(&entry) != CSV_TYPE_RENTAL_INCOME || csv_numFields(entry) != 2) {
+    failed = true;
+    passed = false;
+  }
+  csv_freeEntry(&entry);
+  csv_parseEntry(&entry, "PROPERTIES;9872023VH5797S0001WX", NULL);
+  if (csv_getTypeId(&entry) != CSV_TYPE_UNKNOWN || strcmp(csv_getType(&entry), "PROPERTIES") != 0) {
+    failed = true;
+    passed = false;
+  }
+  csv_freeEntry(&entry);
+  // Lines with many fields split as view entries do
+  strcpy(line, "0");
+  for (i = 1; i < 100; i++) {
+    sprintf(line + strlen(line), ";%d", i);
+  }
+  csv_parseEntry(&entry, line, "NUMBERS");
+  csv_initEntry(&refEntry);
+  csv_parseEntryView(&refEntry, line, strlen(line), "NUMBERS");
+  if (csv_numFields(entry) != 100 || !csv_equalsEntry(entry, refEntry) || csv_getAsInteger(entry, 99) != 99) {
+    failed = true;
+    passed = false;
+  }
+  csv_freeEntry(&entry);
+  csv_freeEntry(&refEntry);
+  end_test(test_section, "CSV_ENTRY_6", !failed);
+
+  /////////////////////////////
+  /////  CSV ENTRY TEST 7  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_ENTRY_7", "Reject entries with empty fields");
+  api_initData(&apiData);
+  // Empty fields in the middle are kept, so both parsers see the same number of fields
+  csv_initEntry(&entry);
+  csv_initEntry(&refEntry);
+  csv_parseEntry(&entry, "A;;1", "LANDLORD");
+  csv_parseEntryView(&refEntry, "LANDLORD;A;;1", 13, NULL);
+  if (csv_numFields(entry) != 3 || !csv_equalsEntry(entry, refEntry) || !csv_hasEmptyField(&entry) ||
+      api_addDataEntry(&apiData, entry) != E_INVALID_ENTRY_FORMAT) {
+    failed = true;
+    passed = false;
+  }
+  csv_freeEntry(&entry);
+  csv_freeEntry(&refEntry);
+  // Every required field of every type is checked
+  for (i = 0; i < 5; i++) {
+    strcpy(line, (i == 0) ? "LANDLORD;;00000000T;1" : (i == 1) ? "TENANT;01/01/2023;31/12/2023;00000000T;;600.0;25;ABC1234" :
+                 (i == 2) ? "LANDLORD;A;00000000T;1" : (i == 3) ? "PROPERTY;ABC1234;;25;00000000T" : "RENTAL_INCOME;2024;;00000000T");
+    csv_parseEntryView(&entry, line, strlen(line), NULL);
+    if (api_addDataEntry_ptr(&apiData, &entry) != ((i == 2) ? E_SUCCESS : E_INVALID_ENTRY_FORMAT)) {
+      failed = true;
+      passed = false;
+    }
+  }
+  csv_freeEntry(&entry);
+  if (apiData.landlords.count != 1 || apiData.tenants.count != 0 || landlords_propertiesCount(apiData.landlords) != 0 ||
+      apiData.rentalIncomes.count != 0) {
+    failed = true;
+    passed = false;
+  }
+  api_freeData(&apiData);
+  end_test(test_section, "CSV_ENTRY_7", !failed);
+
+  return passed;
+}
+
+// Run all tests for CSV readers
+bool run_csv_reader(tTestSection *test_section, const char *input) {
+  tCSVReader reader;
+  tCSVEntry* entry;
+  FILE* fout;
+  const char* filename = "test_csv_reader.csv";
+  char name[1024];
+  tApiData sequential, parallel;
+  tApiError error;
+  int i;
+  bool passed = true;
+  bool failed = false;
+
+  /////////////////////////////
+  /////  CSV READER TEST 1  ///
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_READER_1", "Read the records of a file with a small buffer");
+  fout = fopen(filename, "w");
+  assert(fout != NULL);
+  for (i = 0; i < 1000; i++) {
+    fprintf(fout, "RENTAL_INCOME;%d;%d.25;LANDLORD_WITH_A_LONG_IDENTIFIER_%d\r\n", 2000 + i % 30, i, i);
+    if (i % 100 == 0) {
+      fprintf(fout, "\n");
+    }
+  }
+  fclose(fout);
+  
+  if (!csv_readerOpen(&reader, filename, 16)) {
+    failed = true;
+    passed = false;
+  } else {
+    i = 0;
+    while ((entry = csv_readerNext(&reader, NULL)) != NULL) {
+      if (strcmp(csv_getType(entry), "RENTAL_INCOME") != 0 || csv_numFields(*entry) != 3 ||
+          csv_getAsReal(*entry, 1) != i + 0.25f || csv_readerLine(&reader) != i + 1 + (i + 99) / 100) {
+        failed = true;
+        passed = false;
+      }
+      i++;
+    }
+    if (i != 1000) {
+      failed = true;
+      passed = false;
+    }
+    csv_readerClose(&reader);
+  }
+  remove(filename);
+  end_test(test_section, "CSV_READER_1", !failed);
+
+  /////////////////////////////
+  /////  CSV READER TEST 2  ///
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_READER_2", "Get the offset of the records");
+  fout = fopen(filename, "w");
+  assert(fout != NULL);
+  fprintf(fout, "LANDLORD;John;87654321X;1200.0\nLANDLORD;William;54927077H;1500.0");
+  fclose(fout);
+  
+  if (!csv_readerOpen(&reader, filename, CSV_READER_BUFFER_SIZE)) {
+    failed = true;
+    passed = false;
+  } else {
+    entry = csv_readerNext(&reader, NULL);
+    if (entry == NULL || csv_readerOffset(&reader) != 0) {
+      failed = true;
+      passed = false;
+    }
+    entry = csv_readerNext(&reader, NULL);
+    if (entry == NULL || csv_readerOffset(&reader) != 31 || csv_numFields(*entry) != 3) {
+      failed = true;
+      passed = false;
+    }
+    if (csv_readerNext(&reader, NULL) != NULL) {
+      failed = true;
+      passed = false;
+    }
+    csv_readerClose(&reader);
+  }
+  remove(filename);
+  end_test(test_section, "CSV_READER_2", !failed);
+
+  /////////////////////////////
+  /////  CSV READER TEST 3  ///
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_READER_3", "Load a file in parallel with the same result as a sequential load");
+  fout = fopen(filename, "w");
+  assert(fout != NULL);
+  memset(name, 'N', sizeof(name) - 1);
+  name[sizeof(name) - 1] = '\0';
+  for (i = 0; i < 3000; i++) {
+    fprintf(fout, "TENANT;01/01/2024;31/12/2024;%08d%c;%s;%d.50;30;REF%05d\n", i, validIdLetter(i), name, 500 + i % 100, i);
+    if (i % 500 == 0) {
+      fprintf(fout, "\r\n");
+    }
+  }
+  fprintf(fout, "LANDLORD;John;87654321X;1200.0\nPROPERTY;ABC1234;Balmes;25;87654321X\n");
+  fprintf(fout, "RENTAL_INCOME;2024;8800.55;87654321X\nRENTAL_INCOME;2024;7500.10;54927077H\n");
+  fprintf(fout, "LANDLORD;William;54927077H;1500.0\n");
+  fclose(fout);
+  
+  api_initData(&sequential);
+  api_initData(&parallel);
+  error = api_loadData(&sequential, filename, false);
+  if (api_loadDataParallel(&parallel, filename, false, 4) != error || error != E_LANDLORD_NOT_FOUND ||
+      sequential.tenants.count != 3000 || parallel.tenants.count != 3000 || 
+      parallel.landlords.count != 1 || parallel.landlords.elems[0].properties.count != 1 ||
+      parallel.rentalIncomes.count != 1) {
+    failed = true;
+    passed = false;
+  } else if (sequential.tenants.capacity != 3000 || sequential.landlords.capacity != 2 ||
+      parallel.tenants.capacity != 3000) {
+    // The containers are sized from a scan of the file before loading it
+    failed = true;
+    passed = false;
+  } else {
+    for (i = 0; i < 3000; i++) {
+      if (strcmp(sequential.tenants.elems[i].tenant_id, parallel.tenants.elems[i].tenant_id) != 0 ||
+          sequential.tenants.elems[i].rent != parallel.tenants.elems[i].rent) {
+        failed = true;
+        passed = false;
+      }
+    }
+  }
+  api_freeData(&sequential);
+  api_freeData(&parallel);
+  remove(filename);
+  end_test(test_section, "CSV_READER_3", !failed);
+
+  return passed;
+}
+
+// Size of the header of a snapshot, and offset of its checksum
+#define TEST_SNAPSHOT_HEADER_SIZE 40
+#define TEST_SNAPSHOT_CHECKSUM_OFFSET 32
+
+// Fill with a character the first size bytes of the first field of a snapshot that starts with text, and
+// compute the checksum again so the file is only rejected by the checks of the texts
+static void corruptSnapshotText(const char* filename, const char* text, size_t size, char fill) {
+  FILE* f;
+  char* buffer;
+  uint64_t checksum;
+  long len;
+  long i;
+
+  f = fopen(filename, "r+b");
+  assert(f != NULL);
+  fseek(f, 0, SEEK_END);
+  len = ftell(f);
+  buffer = (char*) malloc(len);
+  assert(buffer != NULL);
+  fseek(f, 0, SEEK_SET);
+  if (fread(buffer, 1, len, f) == (size_t) len) {
+    for (i = TEST_SNAPSHOT_HEADER_SIZE; i + (long) size <= len && strncmp(buffer + i, text, strlen(text)) != 0; i++);
+    assert(i + (long) size <= len);
+    memset(buffer + i, fill, size);
+    // Same FNV-1a checksum as the API: the payload, then the header up to the checksum
+    checksum = 0xcbf29ce484222325ULL;
+    for (i = TEST_SNAPSHOT_HEADER_SIZE; i < len; i++) {
+      checksum = (checksum ^ (unsigned char) buffer[i]) * 0x100000001b3ULL;
+    }
+    for (i = 0; i < TEST_SNAPSHOT_CHECKSUM_OFFSET; i++) {
+      checksum = (checksum ^ (unsigned char) buffer[i]) * 0x100000001b3ULL;
+    }
+    memcpy(buffer + TEST_SNAPSHOT_CHECKSUM_OFFSET, &checksum, sizeof(checksum));
+    fseek(f, 0, SEEK_SET);
+    fwrite(buffer, 1, len, f);
+  }
+  fclose(f);
+  free(buffer);
+}
+
+// Run all tests for data snapshots
+bool run_csv_snapshot(tTestSection *test_section, const char *input) {
+  tApiData data;
+  tApiData loaded;
+  tApiData grown;
+  tLandlord landlord;
+  tRentalIncome income;
+  tRentalIncome *pIncome, *pLoaded;
+  FILE* fout;
+  const char* filename = "test_csv_snapshot.bin";
+  int i, j;
+  bool passed = true;
+  bool failed = false;
+
+  api_initData(&data);
+  api_loadData(&data, input, false);
+
+  /////////////////////////////
+  ///  CSV SNAPSHOT TEST 1  ///
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_SNAPSHOT_1", "Save and load a snapshot of the data");
+  api_initData(&loaded);
+  if (api_saveSnapshot(&data, filename) != E_SUCCESS || api_loadSnapshot(&loaded, filename) != E_SUCCESS ||
+      loaded.tenants.count != data.tenants.count || loaded.landlords.count != data.landlords.count ||
+      loaded.rentalIncomes.count != data.rentalIncomes.count) {
+    failed = true;
+    passed = false;
+  } else {
+    for (i = 0; i < data.tenants.count; i++) {
+      if (strcmp(loaded.tenants.elems[i].tenant_id, data.tenants.elems[i].tenant_id) != 0 ||
+          strcmp(loaded.tenants.elems[i].name, data.tenants.elems[i].name) != 0 ||
+          date_cmp(loaded.tenants.elems[i].end_date, data.tenants.elems[i].end_date) != 0 ||
+          loaded.tenants.elems[i].rent != data.tenants.elems[i].rent) {
+        failed = true;
+        passed = false;
+      }
+    }
+    for (i = 0; i < data.landlords.count; i++) {
+      if (strcmp(loaded.landlords.elems[i].id, data.landlords.elems[i].id) != 0 ||
+          strcmp(loaded.landlords.elems[i].name, data.landlords.elems[i].name) != 0 ||
+          loaded.landlords.elems[i].tax != data.landlords.elems[i].tax ||
+          loaded.landlords.elems[i].properties.count != data.landlords.elems[i].properties.count) {
+        failed = true;
+        passed = false;
+      } else {
+        for (j = 0; j < data.landlords.elems[i].properties.count; j++) {
+          if (strcmp(loaded.landlords.elems[i].properties.elems[j].cadastral_ref, 
+                     data.landlords.elems[i].properties.elems[j].cadastral_ref) != 0) {
+            failed = true;
+            passed = false;
+          }
+        }
+      }
+    }
+    for (i = 0; i < data.rentalIncomes.count; i++) {
+      pIncome = rentalIncomes_get(data.rentalIncomes, i);
+      pLoaded = rentalIncomes_get(loaded.rentalIncomes, i);
+      if (pLoaded->landlord < loaded.landlords.elems || 
+          pLoaded->landlord >= loaded.landlords.elems + loaded.landlords.count ||
+          strcmp(pLoaded->landlord->id, pIncome->landlord->id) != 0 ||
+          pLoaded->year != pIncome->year || pLoaded->totalIncome != pIncome->totalIncome) {
+        failed = true;
+        passed = false;
+      }
+    }
+  }
+  api_freeData(&loaded);
+  end_test(test_section, "CSV_SNAPSHOT_1", !failed);
+
+  /////////////////////////////
+  ///  CSV SNAPSHOT TEST 2  ///
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_SNAPSHOT_2", "Reject a corrupted snapshot");
+  api_initData(&loaded);
+  // Change one byte of the first tenant
+  fout = fopen(filename, "r+b");
+  assert(fout != NULL);
+  fseek(fout, 48, SEEK_SET);
+  fputc('#', fout);
+  fclose(fout);
+  if (api_loadSnapshot(&loaded, filename) != E_INVALID_SNAPSHOT || loaded.tenants.count != 0 ||
+      api_loadSnapshot(&loaded, "missing_snapshot.bin") != E_FILE_NOT_FOUND) {
+    failed = true;
+    passed = false;
+  }
+  // A truncated file is not valid either
+  fout = fopen(filename, "wb");
+  assert(fout != NULL);
+  fputs("UOCT", fout);
+  fclose(fout);
+  if (api_loadSnapshot(&loaded, filename) != E_INVALID_SNAPSHOT) {
+    failed = true;
+    passed = false;
+  }
+  remove(filename);
+  end_test(test_section, "CSV_SNAPSHOT_2", !failed);
+
+  /////////////////////////////
+  ///  CSV SNAPSHOT TEST 3  ///
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_SNAPSHOT_3", "Save a snapshot after the landlords grow");
+  api_initData(&grown);
+  api_initData(&loaded);
+  landlord_init(&landlord);
+  landlord.name = "Landlord";
+  strcpy(landlord.id, "00000000T");
+  landlords_add(&(grown.landlords), landlord);
+  income.landlord = &(grown.landlords.elems[0]);
+  income.year = 2024;
+  income.totalIncome = 350000;
+  rentalIncomes_add(&(grown.rentalIncomes), income);
+  // The landlords are moved to a bigger array, so the landlord of the income is no longer there
+  for (i = 1; i <= 300; i++) {
+    sprintf(landlord.id, "%08dT", i);
+    landlords_add(&(grown.landlords), landlord);
+  }
+  if (api_saveSnapshot(&grown, filename) != E_SUCCESS || api_loadSnapshot(&loaded, filename) != E_SUCCESS ||
+      loaded.landlords.count != 301 || loaded.rentalIncomes.count != 1 ||
+      rentalIncomes_get(loaded.rentalIncomes, 0)->landlord != &(loaded.landlords.elems[0])) {
+    failed = true;
+    passed = false;
+  }
+  api_freeData(&grown);
+  api_freeData(&loaded);
+  remove(filename);
+  end_test(test_section, "CSV_SNAPSHOT_3", !failed);
+
+  /////////////////////////////
+  ///  CSV SNAPSHOT TEST 4  ///
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_SNAPSHOT_4", "Reject texts of a snapshot that cannot be used");
+  // The first snapshot is valid, the others have a text that fills its field with the right checksum
+  api_initData(&loaded);
+  if (api_saveSnapshot(&data, filename) != E_SUCCESS || api_loadSnapshot(&loaded, filename) != E_SUCCESS) {
+    failed = true;
+    passed = false;
+  }
+  api_freeData(&loaded);
+  for (i = 0; i < 4; i++) {
+    api_initData(&loaded);
+    api_saveSnapshot(&data, filename);
+    if (i == 0) {
+      // Cadastral reference of the first tenant
+      corruptSnapshotText(filename, data.tenants.elems[0].cadastral_ref, MAX_CADASTRAL_REF + 1, 'X');
+    } else if (i == 1) {
+      // Street of the first property
+      corruptSnapshotText(filename, data.landlords.elems[0].properties.elems[0].address.street, MAX_STREET, 'X');
+    } else if (i == 2) {
+      // Tenant id, the first text of the payload
+      corruptSnapshotText(filename, data.tenants.elems[0].tenant_id, MAX_PERSON_ID + 1, 'X');
+    } else {
+      // A terminated tenant id that cannot be packed in a key
+      corruptSnapshotText(filename, data.tenants.elems[0].tenant_id, MAX_PERSON_ID, '\xd1');
+    }
+    if (api_loadSnapshot(&loaded, filename) != E_INVALID_SNAPSHOT || loaded.tenants.count != 0) {
+      failed = true;
+      passed = false;
+    }
+  }
+  remove(filename);
+  end_test(test_section, "CSV_SNAPSHOT_4", !failed);
+
+  api_freeData(&data);
+
+  return passed;
+}
+
+// Run all tests for CSV writers
+bool run_csv_writer(tTestSection *test_section, const char *input) {
+  tCSVWriter writer;
+  tApiData data;
+  tApiData loaded;
+  tLandlord landlord;
+  tRentalIncome income;
+  FILE* fin;
+  const char* filename = "test_csv_writer.csv";
+  const char* expected = "TEST;-42;0;9223372036854775807;888.25;-0.50;7.0;0.00;05/01/2024;1000000.01\nLAST\n";
+  char name[200];
+  char buffer[256];
+  int len;
+  int i;
+  bool passed = true;
+  bool failed = false;
+
+  /////////////////////////////
+  /////  CSV WRITER TEST 1  ///
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_WRITER_1", "Write records with a small buffer");
+  if (!csv_writerOpen(&writer, filename, CSV_WRITER_MIN_BUFFER)) {
+    failed = true;
+    passed = false;
+  } else {
+    csv_writeString(&writer, "TEST");
+    csv_writeInteger(&writer, -42);
+    csv_writeInteger(&writer, 0);
+    csv_writeInteger(&writer, 9223372036854775807LL);
+    csv_writeReal(&writer, 888.25, 2);
+    csv_writeReal(&writer, -0.499, 2);
+    csv_writeReal(&writer, 6.96, 1);
+    csv_writeReal(&writer, -0.001, 2);
+    csv_writeDate(&writer, 5, 1, 2024);
+    csv_writeReal(&writer, 1000000.005, 2);
+    csv_writeEndRecord(&writer);
+    csv_writeString(&writer, "LAST");
+    csv_writeEndRecord(&writer);
+    if (!csv_writerClose(&writer)) {
+      failed = true;
+      passed = false;
+    }
+    fin = fopen(filename, "rb");
+    assert(fin != NULL);
+    len = fread(buffer, 1, sizeof(buffer) - 1, fin);
+    buffer[len] = '\0';
+    fclose(fin);
+    if (strcmp(buffer, expected) != 0) {
+      failed = true;
+      passed = false;
+    }
+  }
+  
+  // Texts longer than the buffer are written directly
+  memset(name, 'N', sizeof(name) - 1);
+  name[sizeof(name) - 1] = '\0';
+  if (!csv_writerOpen(&writer, filename, CSV_WRITER_MIN_BUFFER)) {
+    failed = true;
+    passed = false;
+  } else {
+    csv_writeString(&writer, "TEST");
+    csv_writeString(&writer, name);
+    csv_writeInteger(&writer, 1);
+    csv_writeEndRecord(&writer);
+    csv_writerClose(&writer);
+    fin = fopen(filename, "rb");
+    assert(fin != NULL);
+    len = fread(buffer, 1, sizeof(buffer) - 1, fin);
+    buffer[len] = '\0';
+    fclose(fin);
+    if (len != 5 + 199 + 3 || strncmp(buffer, "TEST;NNN", 8) != 0 || strcmp(buffer + 204, ";1\n") != 0) {
+      failed = true;
+      passed = false;
+    }
+  }
+  remove(filename);
+  end_test(test_section, "CSV_WRITER_1", !failed);
+
+  /////////////////////////////
+  /////  CSV WRITER TEST 2  ///
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_WRITER_2", "Export the data and load it again");
+  api_initData(&data);
+  api_initData(&loaded);
+  if (api_loadData(&data, input, false) != E_SUCCESS || api_saveData(&data, filename) != E_SUCCESS ||
+      api_loadData(&loaded, filename, false) != E_SUCCESS ||
+      loaded.tenants.count != data.tenants.count || loaded.landlords.count != data.landlords.count ||
+      loaded.rentalIncomes.count != data.rentalIncomes.count) {
+    failed = true;
+    passed = false;
+  } else {
+    for (i = 0; i < data.tenants.count; i++) {
+      if (strcmp(loaded.tenants.elems[i].name, data.tenants.elems[i].name) != 0 ||
+          date_cmp(loaded.tenants.elems[i].start_date, data.tenants.elems[i].start_date) != 0 ||
+          loaded.tenants.elems[i].rent != data.tenants.elems[i].rent) {
+        failed = true;
+        passed = false;
+      }
+    }
+    for (i = 0; i < data.landlords.count; i++) {
+      if (strcmp(loaded.landlords.elems[i].id, data.landlords.elems[i].id) != 0 ||
+          loaded.landlords.elems[i].tax != data.landlords.elems[i].tax ||
+          loaded.landlords.elems[i].properties.count != data.landlords.elems[i].properties.count) {
+        failed = true;
+        passed = false;
+      }
+    }
+  }
+  api_freeData(&data);
+  api_freeData(&loaded);
+  remove(filename);
+  end_test(test_section, "CSV_WRITER_2", !failed);
+
+  /////////////////////////////
+  /////  CSV WRITER TEST 3  ///
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_WRITER_3", "Export the data after the landlords grow");
+  api_initData(&data);
+  api_initData(&loaded);
+  landlord_init(&landlord);
+  landlord.name = "Landlord";
+  strcpy(landlord.id, "00000000T");
+  landlords_add(&(data.landlords), landlord);
+  income.landlord = &(data.landlords.elems[0]);
+  income.year = 2024;
+  income.totalIncome = 350000;
+  rentalIncomes_add(&(data.rentalIncomes), income);
+  // The landlords are moved to a bigger array, so the landlord of the income is no longer there
+  for (i = 1; i <= 300; i++) {
+    sprintf(landlord.id, "%08d%c", i, validIdLetter(i));
+    landlords_add(&(data.landlords), landlord);
+  }
+  if (api_saveData(&data, filename) != E_SUCCESS || api_loadData(&loaded, filename, false) != E_SUCCESS ||
+      loaded.landlords.count != 301 || loaded.rentalIncomes.count != 1 ||
+      rentalIncomes_find_ptr(&(loaded.rentalIncomes), 2024, "00000000T") == NULL ||
+      rentalIncomes_find_ptr(&(loaded.rentalIncomes), 2024, "00000000T")->totalIncome != 350000) {
+    failed = true;
+    passed = false;
+  }
+  api_freeData(&data);
+  api_freeData(&loaded);
+  remove(filename);
+  end_test(test_section, "CSV_WRITER_3", !failed);
+
+  return passed;
+}
+
+// Run all tests for the indexes of the data
+bool run_csv_index(tTestSection *test_section, const char *input) {
+  tLandlords landlords;
+  tLandlord landlord;
+  tTenantData tenants;
+  tTenant tenant;
+  tProperty property;
+  tRentalIncomeList incomes;
+  tRentalIncome income;
+  tRentalIncome* pIncome;
+  tRentalIncome* pNext;
+  int value, run;
+  char id[MAX_PERSON_ID + 1];
+  char text[KEY_MAX_LENGTH + 1];
+  tApiData data;
+  char* name;
+  int i;
+  bool passed = true;
+  bool failed = false;
+
+  /////////////////////////////
+  /////  CSV INDEX TEST 1  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_INDEX_1", "Find landlords by id");
+  landlords_init(&landlords);
+  landlord_init(&landlord);
+  landlord.name = "Landlord";
+  landlord.tax = 0;
+  properties_init(&(landlord.properties));
+  landlords_reserve(&landlords, 5000);
+  if (landlords.capacity != 5000 || landlords.count != 0) {
+    failed = true;
+    passed = false;
+  }
+  for (i = 0; i < 5000; i++) {
+    sprintf(landlord.id, "%08dL", i);
+    landlords_add(&landlords, landlord);
+  }
+  // Duplicated landlords are not added
+  landlords_add(&landlords, landlord);
+  if (landlords.count != 5000 || landlords_find(landlords, "99999999L") != -1) {
+    failed = true;
+    passed = false;
+  }
+  for (i = 0; i < 5000; i++) {
+    sprintf(id, "%08dL", i);
+    if (landlords_find(landlords, id) != i) {
+      failed = true;
+      passed = false;
+    }
+  }
+  // Removing a landlord moves the following ones
+  landlords_del(&landlords, "00000010L");
+  if (landlords.count != 4999 || landlords_find(landlords, "00000010L") != -1 ||
+      landlords_find(landlords, "00000009L") != 9 || landlords_find(landlords, "00000011L") != 10 ||
+      landlords_find(landlords, "00004999L") != 4998) {
+    failed = true;
+    passed = false;
+  }
+  // Moved landlords keep their memory, and the source is left without it
+  name = (char*) malloc(6 * sizeof(char));
+  strcpy(name, "Moved");
+  landlord.name = name;
+  strcpy(landlord.id, "00005000L");
+  if (!landlords_add_move(&landlords, &landlord) || landlord.name != NULL || landlords.count != 5000 ||
+      landlords.elems[4999].name != name || landlords_find(landlords, "00005000L") != 4999 ||
+      landlords_add_move(&landlords, &landlord) || landlords.count != 5000) {
+    failed = true;
+    passed = false;
+  }
+  landlord.name = "Landlord";
+  // Removed landlords keep their memory until it is released
+  landlords_del(&landlords, "00000000L");
+  if (landlords.capacity < 5000 || landlords.count != 4999) {
+    failed = true;
+    passed = false;
+  }
+  landlords_shrink(&landlords);
+  if (landlords.capacity != 4999 || landlords.count != 4999 || landlords_find(landlords, "00005000L") != 4998) {
+    failed = true;
+    passed = false;
+  }
+  landlords_free(&landlords);
+  end_test(test_section, "CSV_INDEX_1", !failed);
+
+  /////////////////////////////
+  /////  CSV INDEX TEST 2  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_INDEX_2", "Find tenants by id");
+  tenantData_init(&tenants);
+  tenant_init(&tenant);
+  tenant.name = "Tenant";
+  strcpy(tenant.cadastral_ref, "ABC1234");
+  for (i = 0; i < 5000; i++) {
+    sprintf(tenant.tenant_id, "%08dT", i);
+    tenantData_add(&tenants, tenant);
+  }
+  // The capacity grows geometrically
+  if (tenants.capacity < 5000 || tenants.capacity >= 10000) {
+    failed = true;
+    passed = false;
+  }
+  // Duplicated tenants are not added
+  tenantData_add(&tenants, tenant);
+  if (tenants.count != 5000 || tenantData_find(tenants, "99999999T") != -1 || tenantData_find(tenants, "") != -1) {
+    failed = true;
+    passed = false;
+  }
+  for (i = 0; i < 5000; i++) {
+    sprintf(id, "%08dT", i);
+    if (tenantData_find(tenants, id) != i) {
+      failed = true;
+      passed = false;
+    }
+  }
+  // Moved tenants keep their memory, and the source is left without it
+  name = (char*) malloc(6 * sizeof(char));
+  strcpy(name, "Moved");
+  tenant.name = name;
+  strcpy(tenant.tenant_id, "00005000T");
+  if (!tenantData_add_move(&tenants, &tenant) || tenant.name != NULL || tenants.count != 5001 ||
+      tenants.elems[5000].name != name || tenantData_find(tenants, "00005000T") != 5000 ||
+      tenantData_add_move(&tenants, &tenant) || tenants.count != 5001) {
+    failed = true;
+    passed = false;
+  }
+  tenant.name = "Tenant";
+  for (i = 0; i < tenants.count; i++) {
+    tenant_free(&(tenants.elems[i]));
+  }
+  tenantData_free(&tenants);
+  if (tenantData_find(tenants, "00000000T") != -1) {
+    failed = true;
+    passed = false;
+  }
+  end_test(test_section, "CSV_INDEX_2", !failed);
+
+  /////////////////////////////
+  /////  CSV INDEX TEST 3  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_INDEX_3", "Find the owners of the properties");
+  landlords_init(&landlords);
+  for (i = 0; i < 3; i++) {
+    sprintf(landlord.id, "%08dL", i);
+    landlords_add(&landlords, landlord);
+  }
+  strcpy(property.address.street, "Balmes");
+  for (i = 0; i < 30; i++) {
+    sprintf(property.cadastral_ref, "REF%04d", i);
+    sprintf(property.landlord_id, "%08dL", i % 3);
+    property.address.number = i;
+    landlord_add_property(&landlords, property);
+  }
+  // A property cannot belong to two landlords
+  strcpy(property.cadastral_ref, "REF0000");
+  strcpy(property.landlord_id, "00000002L");
+  landlord_add_property(&landlords, property);
+  if (landlords_propertiesCount(landlords) != 30 || landlords_find_by_cadastral_ref(landlords, "REF0000") != 0 ||
+      landlords_find_property(landlords, "REF0029", &value) != 2 || value != 9 ||
+      landlords_find_property(landlords, "REF0030", &value) != -1 || value != -1 ||
+      landlords_find_property_ptr(&landlords, "REF0029", &value) != 2 || value != 9 ||
+      landlords_find_ptr(&landlords, "00000002L") != 2 || properties_find_ptr(&(landlords.elems[2].properties), "REF0029") != 9) {
+    failed = true;
+    passed = false;
+  }
+  // Removing a landlord removes its properties and moves the following ones
+  landlords_del(&landlords, "00000001L");
+  if (landlords_propertiesCount(landlords) != 20 || landlords_find_by_cadastral_ref(landlords, "REF0001") != -1 ||
+      landlords_find_property(landlords, "REF0029", &value) != 1 || value != 9) {
+    failed = true;
+    passed = false;
+  }
+  // A landlord can have any number of properties
+  for (i = 0; i < 5000; i++) {
+    sprintf(property.cadastral_ref, "BIG%04d", i);
+    strcpy(property.landlord_id, "00000002L");
+    landlord_add_property(&landlords, property);
+  }
+  if (landlords_propertiesCount(landlords) != 5020 || properties_len(landlords.elems[1]) != 5010 ||
+      landlords_find_property(landlords, "BIG4999", &value) != 1 || value != 5009 ||
+      strcmp(landlords.elems[1].properties.elems[5009].cadastral_ref, "BIG4999") != 0) {
+    failed = true;
+    passed = false;
+  }
+  landlords_free(&landlords);
+  end_test(test_section, "CSV_INDEX_3", !failed);
+
+  /////////////////////////////
+  /////  CSV INDEX TEST 4  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_INDEX_4", "Find rental incomes by year and landlord");
+  landlords_init(&landlords);
+  for (i = 0; i < 10; i++) {
+    sprintf(landlord.id, "%08dL", i);
+    landlords_add(&landlords, landlord);
+  }
+  rentalIncomes_init(&incomes);
+  // Add them in an order different from the one of the list
+  for (i = 0; i < 1000; i++) {
+    income.landlord = &(landlords.elems[(i * 37) % 1000 % 10]);
+    income.year = 2000 + (i * 37) % 1000 / 10;
+    income.totalIncome = i;
+    if (rentalIncomes_add(&incomes, income) != E_SUCCESS) {
+      failed = true;
+      passed = false;
+    }
+  }
+  if (incomes.count != 1000 || rentalIncomes_add(&incomes, income) != E_RENTAL_INCOME_DUPLICATED || 
+      incomes.count != 1000 || rentalIncomes_position(incomes, 2100, "00000000L") != -1 ||
+      rentalIncomes_position(incomes, 2000, "99999999L") != -1) {
+    failed = true;
+    passed = false;
+  }
+  for (i = 0; i < 1000; i++) {
+    value = rentalIncomes_position(incomes, 2000 + (i * 37) % 1000 / 10, landlords.elems[(i * 37) % 1000 % 10].id);
+    if (value < 0 || rentalIncomes_get(incomes, value)->totalIncome != i ||
+        rentalIncomes_find_ptr(&incomes, 2000 + (i * 37) % 1000 / 10, landlords.elems[(i * 37) % 1000 % 10].id) != 
+        rentalIncomes_get_ptr(&incomes, value)) {
+      failed = true;
+      passed = false;
+    }
+  }
+  // The list is sorted by year and landlord
+  for (i = 1; i < incomes.count; i++) {
+    pIncome = rentalIncomes_get(incomes, i - 1);
+    pNext = rentalIncomes_get(incomes, i);
+    if (pIncome->year > pNext->year || (pIncome->year == pNext->year &&
+        strcmp(pIncome->landlord->id, pNext->landlord->id) >= 0)) {
+      failed = true;
+      passed = false;
+    }
+  }
+  rentalIncomes_free(&incomes);
+  end_test(test_section, "CSV_INDEX_4", !failed);
+  
+  /////////////////////////////
+  /////  CSV INDEX TEST 5  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_INDEX_5", "Add rental incomes in bulk mode");
+  rentalIncomes_init(&incomes);
+  rentalIncomes_beginBulk(&incomes);
+  for (i = 0; i < 1000; i++) {
+    income.landlord = &(landlords.elems[(i * 37) % 1000 % 10]);
+    income.year = 1950 + (i * 37) % 1000 / 10 * 3;
+    income.totalIncome = i;
+    if (rentalIncomes_add(&incomes, income) != E_SUCCESS) {
+      failed = true;
+      passed = false;
+    }
+  }
+  // Duplicates are only detected when the bulk mode ends, keeping the first element
+  income.landlord = &(landlords.elems[0]);
+  income.year = 1950;
+  income.totalIncome = -1;
+  rentalIncomes_add(&incomes, income);
+  if (incomes.count != 1001 || rentalIncomes_endBulk(&incomes) != E_RENTAL_INCOME_DUPLICATED || 
+      incomes.count != 1000 || incomes.bulk) {
+    failed = true;
+    passed = false;
+  }
+  for (i = 0; i < 1000; i++) {
+    value = rentalIncomes_position(incomes, 1950 + (i * 37) % 1000 / 10 * 3, landlords.elems[(i * 37) % 1000 % 10].id);
+    if (value < 0 || rentalIncomes_get(incomes, value)->totalIncome != i) {
+      failed = true;
+      passed = false;
+    }
+  }
+  for (i = 1; i < incomes.count; i++) {
+    pIncome = rentalIncomes_get(incomes, i - 1);
+    pNext = rentalIncomes_get(incomes, i);
+    if (pIncome->year > pNext->year || (pIncome->year == pNext->year &&
+        strcmp(pIncome->landlord->id, pNext->landlord->id) >= 0)) {
+      failed = true;
+      passed = false;
+    }
+  }
+  // Once the mode ends, duplicates are rejected again
+  if (rentalIncomes_add(&incomes, income) != E_RENTAL_INCOME_DUPLICATED || incomes.count != 1000) {
+    failed = true;
+    passed = false;
+  }
+  rentalIncomes_free(&incomes);
+  landlords_free(&landlords);
+  end_test(test_section, "CSV_INDEX_5", !failed);
+
+  /////////////////////////////
+  /////  CSV INDEX TEST 6  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_INDEX_6", "Pack ids in keys");
+  // Keys compare as their texts
+  if (key_pack("87654321X") != key_pack("87654321X") || key_pack("87654321X") <= key_pack("12345678Z") ||
+      key_pack("ABC") >= key_pack("ABC1234") || key_pack("") != 0 || key_pack("ABC1234") <= key_pack("ABC1233")) {
+    failed = true;
+    passed = false;
+  }
+  // Only short ASCII texts can be packed
+  if (key_pack("1234567890") != KEY_INVALID || key_pack("12345\xc3\x91") != KEY_INVALID) {
+    failed = true;
+    passed = false;
+  }
+  for (i = 0; i < 1000; i++) {
+    sprintf(id, "%08d%c", i * 97, 'A' + i % 26);
+    key_unpack(key_pack(id), text);
+    if (strcmp(id, text) != 0) {
+      failed = true;
+      passed = false;
+    }
+  }
+  // Records whose id cannot be packed are not added
+  api_initData(&data);
+  landlord_init(&landlord);
+  landlord.name = "Landlord";
+  strcpy(landlord.id, "1234567\xd1");
+  landlords_add(&(data.landlords), landlord);
+  tenant_init(&tenant);
+  tenant.name = "Tenant";
+  strcpy(tenant.tenant_id, "1234567\xd1");
+  tenantData_add(&(data.tenants), tenant);
+  if (data.landlords.count != 0 || data.tenants.count != 0 || 
+      landlords_add_move(&(data.landlords), &landlord) || tenantData_add_move(&(data.tenants), &tenant)) {
+    failed = true;
+    passed = false;
+  }
+  // Ids changed by hand are left out of the indexes
+  strcpy(landlord.id, "00000000T");
+  landlords_add(&(data.landlords), landlord);
+  strcpy(data.landlords.elems[0].id, "1234567\xd1");
+  strcpy(tenant.tenant_id, "00000000T");
+  tenantData_add(&(data.tenants), tenant);
+  strcpy(data.tenants.elems[0].tenant_id, "1234567\xd1");
+  if (landlords_reindex(&(data.landlords)) || landlords_find_ptr(&(data.landlords), "00000000T") != -1 ||
+      tenantData_reindex(&(data.tenants)) || tenantData_find_ptr(&(data.tenants), "00000000T") != -1) {
+    failed = true;
+    passed = false;
+  }
+  tenant_free(&(data.tenants.elems[0]));
+  tenantData_free(&(data.tenants));
+  landlords_free(&(data.landlords));
+  rentalIncomes_free(&(data.rentalIncomes));
+  end_test(test_section, "CSV_INDEX_6", !failed);
+
+  /////////////////////////////
+  /////  CSV INDEX TEST 7  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "CSV_INDEX_7", "Add rental incomes at any position");
+  landlords_init(&landlords);
+  for (i = 0; i < 10; i++) {
+    sprintf(landlord.id, "%08dL", i);
+    landlords_add(&landlords, landlord);
+  }
+  rentalIncomes_init(&incomes);
+  // Odd values from the last to the first, and then even values, so every element goes before or between
+  // others. Each value is the position of its element in the list
+  for (i = 0; i < 20000; i++) {
+    value = (i < 10000) ? 19999 - 2 * i : 2 * (i - 10000);
+    income.landlord = &(landlords.elems[value % 10]);
+    income.year = value / 10;
+    income.totalIncome = value;
+    if (rentalIncomes_add(&incomes, income) != E_SUCCESS) {
+      failed = true;
+      passed = false;
+    }
+  }
+  if (incomes.count != 20000 || rentalIncomes_total(&incomes) != 199990000) {
+    failed = true;
+    passed = false;
+  }
+  for (i = 0; i < 20000; i++) {
+    if (rentalIncomes_get(incomes, i)->totalIncome != i ||
+        rentalIncomes_position(incomes, i / 10, landlords.elems[i % 10].id) != i) {
+      failed = true;
+      passed = false;
+    }
+  }
+  // The runs of contiguous elements cover the list in order
+  for (i = 0; i < incomes.count; i += run) {
+    run = rentalIncomes_getRun(&incomes, i, &pIncome, NULL);
+    if (run < 1 || i + run > incomes.count || pIncome[0].totalIncome != i || pIncome[run - 1].totalIncome != i + run - 1) {
+      failed = true;
+      passed = false;
+      break;
+    }
+  }
+  // Elements added in bulk mode are merged with the others, which are kept over duplicates
+  rentalIncomes_beginBulk(&incomes);
+  for (i = 20099; i >= 20000; i--) {
+    income.landlord = &(landlords.elems[i % 10]);
+    income.year = i / 10;
+    income.totalIncome = i;
+    rentalIncomes_add(&incomes, income);
+  }
+  income.landlord = &(landlords.elems[5]);
+  income.year = 0;
+  income.totalIncome = -1;
+  rentalIncomes_add(&incomes, income);
+  if (rentalIncomes_endBulk(&incomes) != E_RENTAL_INCOME_DUPLICATED || incomes.count != 20100 ||
+      rentalIncomes_get(incomes, 5)->totalIncome != 5 || rentalIncomes_get(incomes, 20050)->totalIncome != 20050 ||
+      rentalIncomes_position(incomes, 2009, landlords.elems[9].id) != 20099) {
+    failed = true;
+    passed = false;
+  }
+  rentalIncomes_free(&incomes);
+  landlords_free(&landlords);
+  end_test(test_section, "CSV_INDEX_7", !failed);
+
+  return passed;
+}
+
+// Run all tests for the validation of person ids
+bool run_person_id(tTestSection *test_section, const char *input) {
+  tTenant tenant;
+  tLandlord landlord;
+  char ids[1001][MAX_PERSON_ID + 1];
+  char block[1001 * PERSON_ID_LENGTH];
+  bool valid[1001];
+  int number;
+  tApiData data;
+  tCSVEntry entry;
+  char line[128];
+  int i;
+  bool passed = true;
+  bool failed = false;
+
+  /////////////////////////////
+  /////  PERSON ID TEST 1  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "PERSON_ID_1", "Validate the control letter of the ids");
+  if (!personId_isValid("00000000T") || !personId_isValid("54927077H") || !personId_isValid("12345678Z") ||
+      !personId_isValid("X1234567L") || !personId_isValid("Y1234567X") || personId_isValid("12345678A") ||
+      personId_isValid("1234567Z") || personId_isValid("1234A678Z") || personId_isValid("A1234567L")) {
+    failed = true;
+    passed = false;
+  }
+  // The block validator gives the same result as the single one. Every third id has a wrong letter, and
+  // every fifth one is a NIE
+  for (i = 0; i < 1001; i++) {
+    if (i % 5 == 0) {
+      number = (i % 3) * 10000000 + (i * 99991) % 10000000;
+      sprintf(ids[i], "%c%07d%c", 'X' + i % 3, (i * 99991) % 10000000, validIdLetter(number + (i % 3 == 0)));
+    } else {
+      sprintf(ids[i], "%08d%c", i * 99991, validIdLetter(i * 99991 + (i % 3 == 0)));
+    }
+  }
+  strcpy(ids[1000], "1234A678Z");
+  for (i = 0; i < 1001; i++) {
+    memcpy(block + i * PERSON_ID_LENGTH, ids[i], PERSON_ID_LENGTH);
+  }
+  if (personId_validateBlock(block, 1001, valid) != 666 || personId_validateBlock(block, 0, valid) != 0) {
+    failed = true;
+    passed = false;
+  }
+  for (i = 0; i < 1001; i++) {
+    if (valid[i] != personId_isValid(ids[i]) || valid[i] != (i % 3 != 0 && i != 1000)) {
+      failed = true;
+      passed = false;
+    }
+  }
+  // Count the invalid ids of the data
+  api_initData(&data);
+  tenant_init(&tenant);
+  tenant.name = "Tenant";
+  for (i = 0; i < 600; i++) {
+    strcpy(tenant.tenant_id, ids[i]);
+    tenantData_add(&(data.tenants), tenant);
+  }
+  landlord_init(&landlord);
+  landlord.name = "Landlord";
+  for (i = 600; i < 1001; i++) {
+    strcpy(landlord.id, ids[i]);
+    landlords_add(&(data.landlords), landlord);
+  }
+  if (api_invalidIdsCount(&data) != 335) {
+    failed = true;
+    passed = false;
+  }
+  for (i = 0; i < data.tenants.count; i++) {
+    tenant_free(&(data.tenants.elems[i]));
+  }
+  tenantData_free(&(data.tenants));
+  landlords_free(&(data.landlords));
+  rentalIncomes_free(&(data.rentalIncomes));
+  end_test(test_section, "PERSON_ID_1", !failed);
+
+  /////////////////////////////
+  /////  PERSON ID TEST 2  ////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "PERSON_ID_2", "Reject records whose id has a wrong control letter");
+  api_initData(&data);
+  csv_initEntry(&entry);
+  for (i = 0; i < 4; i++) {
+    strcpy(line, (i == 0) ? "LANDLORD;John;87654321K;1200.0" : (i == 1) ? "LANDLORD;John;X1234567L;1200.0" : 
+                 (i == 2) ? "TENANT;01/01/2024;31/12/2024;12345678A;Lucas;600.0;25;ABC1234" : 
+                 "TENANT;01/01/2024;31/12/2024;12345678Z;Lucas;600.0;25;ABC1234");
+    csv_parseEntryView(&entry, line, strlen(line), NULL);
+    if (api_addDataEntry_ptr(&data, &entry) != ((i % 2 == 1) ? E_SUCCESS : E_INVALID_ENTRY_FORMAT)) {
+      failed = true;
+      passed = false;
+    }
+  }
+  csv_freeEntry(&entry);
+  if (data.landlords.count != 1 || data.tenants.count != 1 || api_invalidIdsCount(&data) != 0) {
+    failed = true;
+    passed = false;
+  }
+  api_freeData(&data);
+  end_test(test_section, "PERSON_ID_2", !failed);
+
+  return passed;
+}
+
+// Run all tests for amounts of money
+bool run_money(tTestSection *test_section, const char *input) {
+  tLandlords landlords;
+  tLandlord landlord;
+  tTenant tenant;
+  tProperty property;
+  tRentalIncomeList incomes;
+  tRentalIncome income;
+  tMoney amounts[1001];
+  tMoney total;
+  tCSVEntry entry;
+  char buffer[64];
+  int i;
+  bool passed = true;
+  bool failed = false;
+
+  /////////////////////////////
+  ///////  MONEY TEST 1  //////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "MONEY_1", "Money in cents");
+  // Percentages are rounded half away from zero
+  if (money_percent(1005, 10) != 101 || money_percent(-1005, 10) != -101 || money_percent(333, 20) != 67 ||
+      money_percent(0, 20) != 0 || AMOUNT_NO_RENT != 15000) {
+    failed = true;
+    passed = false;
+  }
+  // Sums of any length, including the ones not multiple of the vector width
+  total = 0;
+  for (i = 0; i < 1001; i++) {
+    amounts[i] = (tMoney) i * 1000000007LL - 3000;
+    if (money_sum(amounts, i) != total) {
+      failed = true;
+      passed = false;
+    }
+    total += amounts[i];
+  }
+  if (money_sum(amounts, 1001) != total || money_sum(NULL, 0) != 0) {
+    failed = true;
+    passed = false;
+  }
+  // Amounts are parsed as cents
+  csv_initEntry(&entry);
+  csv_parseEntry(&entry, "01/01/2024;31/12/2024;12345678Z;Lucas;650.55;30;ABC1234", "TENANT");
+  tenant_init(&tenant);
+  if (!tenant_parse(&tenant, entry) || tenant.rent != 65055) {
+    failed = true;
+    passed = false;
+  }
+  csv_freeEntry(&entry);
+  // The tax is computed with integer arithmetic: 10% of 12 months of 650.55 is 780.66
+  landlords_init(&landlords);
+  landlord_init(&landlord);
+  landlord.name = "Landlord";
+  landlord.tax = 0;
+  strcpy(landlord.id, "87654321X");
+  landlords_add(&landlords, landlord);
+  strcpy(property.cadastral_ref, "ABC1234");
+  strcpy(property.address.street, "Balmes");
+  property.address.number = 25;
+  strcpy(property.landlord_id, "87654321X");
+  landlord_add_property(&landlords, property);
+  landlords_process_tenant(&landlords, tenant);
+  landlord_get(landlords, 0, buffer);
+  if (landlords.elems[0].tax != 78066 || strcmp(buffer, "Landlord;87654321X,780.7") != 0) {
+    failed = true;
+    passed = false;
+  }
+  buffer[0] = '\0';
+  landlord_get_ptr(&landlords, 0, buffer);
+  if (strcmp(buffer, "Landlord;87654321X,780.7") != 0) {
+    failed = true;
+    passed = false;
+  }
+  // Totals of landlords and rental incomes
+  strcpy(landlord.id, "12345678Z");
+  landlord.tax = -66;
+  landlords_add(&landlords, landlord);
+  if (landlords_totalTax(&landlords) != 78000) {
+    failed = true;
+    passed = false;
+  }
+  rentalIncomes_init(&incomes);
+  income.landlord = &(landlords.elems[0]);
+  total = 0;
+  for (i = 0; i < 600; i++) {
+    income.year = 1500 + i;
+    income.totalIncome = (tMoney) i * 12345 - 99;
+    total += income.totalIncome;
+    rentalIncomes_add(&incomes, income);
+  }
+  if (rentalIncomes_total(&incomes) != total) {
+    failed = true;
+    passed = false;
+  }
+  tenant_free(&tenant);
+  rentalIncomes_free(&incomes);
+  landlords_free(&landlords);
+  end_test(test_section, "MONEY_1", !failed);
+
+  return passed;
+}
+
+// Run tests for the taxes of the landlords
+bool run_landlord(tTestSection *test_section, const char *input) {
+  tLandlords landlords;
+  tLandlord landlord;
+  tProperty property;
+  tApiData data;
+  tMoney total;
+  int i;
+  bool passed = true;
+  bool failed = false;
+
+  /////////////////////////////
+  /////  LANDLORD TEST 1  /////
+  /////////////////////////////
+  failed = false;
+  start_test(test_section, "LANDLORD_1", "Taxes of the landlords");
+  landlords_init(&landlords);
+  landlord_init(&landlord);
+  landlord.name = "Landlord";
+  total = 0;
+  for (i = 0; i < 1000; i++) {
+    sprintf(landlord.id, "%08dL", i);
+    landlord.tax = (tMoney) i * 101 - 5000;
+    total += landlord.tax;
+    landlords_add(&landlords, landlord);
+  }
+  // Properties add to the tax of their landlord
+  strcpy(property.cadastral_ref, "ABC1234");
+  strcpy(property.address.street, "Balmes");
+  property.address.number = 25;
+  strcpy(property.landlord_id, "00000500L");
+  landlord_add_property(&landlords, property);
+  total += AMOUNT_NO_RENT * 12;
+  // Removing a landlord moves the following ones
+  landlords_del(&landlords, "00000000L");
+  total += 5000;
+  if (landlords.count != 999 || strcmp(landlords.elems[499].id, "00000500L") != 0 || 
+      landlords_tax(&landlords, 499) != 500 * 101 - 5000 + AMOUNT_NO_RENT * 12 || landlords_totalTax(&landlords) != total) {
+    failed = true;
+    passed = false;
+  }
+  // Taxes are added through the landlords, keeping the elements and the column in sync
+  landlords_addTax(&landlords, 998, 1234);
+  total += 1234;
+  if (landlords_tax(&landlords, 998) != landlords.elems[998].tax || landlords_totalTax(&landlords) != total ||
+      landlords_key(&landlords, 998) != key_pack("00000999L") || strcmp(landlords_name(&landlords, 998), "Landlord") != 0) {
+    failed = true;
+    passed = false;
+  }
+  // Elements changed by hand are seen by the accessors once the landlords are reindexed
+  landlords.elems[997].tax += 66;
+  total += 66;
+  if (!landlords_reindex(&landlords) || landlords_tax(&landlords, 997) != landlords.elems[997].tax ||
+      landlords_totalTax(&landlords) != total) {
+    failed = true;
+    passed = false;
+  }
+  // Copies have the tax set to 0
+  landlords_cpy(&(data.landlords), landlords);
+  if (landlords_totalTax(&(data.landlords)) != 0 || landlords_find_ptr(&(data.landlords), "00000999L") != 998 ||
+      !mismatch_tax_declaration(landlords, data.landlords, 499) || mismatch_tax_declaration(landlords, data.landlords, 0) ||
+      !mismatch_tax_declaration_ptr(&landlords, &(data.landlords), 499) || 
+      mismatch_tax_declaration_ptr(&landlords, &(data.landlords), 0)) {
+    failed = true;
+    passed = false;
+  }
+  landlords_free(&(data.landlords));
+  landlords_free(&landlords);
+  end_test(test_section, "LANDLORD_1", !failed);
+
+  return passed;
+}
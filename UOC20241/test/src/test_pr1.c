@@ -83,7 +83,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     failed = true;
   } else {
     csv_initEntry(&entry);
-    csv_parseEntry(&entry, "01/01/2023;31/12/2023;12345678A;Lucas;600.0;25;ABC1234;EXTRA", "TENANTT");
+    csv_parseEntry(&entry, "01/01/2023;31/12/2023;12345678Z;Lucas;600.0;25;ABC1234;EXTRA", "TENANTT");
 	
     error = api_addTenant(&data, entry);
     if (error != E_INVALID_ENTRY_TYPE) {
@@ -94,7 +94,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     csv_freeEntry(&entry);
 	
 	csv_initEntry(&entry);
-	csv_parseEntry(&entry, "01/01/2023;31/12/2023;12345678A;Lucas;600.0;25;ABC1234;EXTRA", "TENANT");
+	csv_parseEntry(&entry, "01/01/2023;31/12/2023;12345678Z;Lucas;600.0;25;ABC1234;EXTRA", "TENANT");
 	
     error = api_addTenant(&data, entry);
     if (error != E_INVALID_ENTRY_FORMAT) {
@@ -105,7 +105,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     csv_freeEntry(&entry);
 	
 	csv_initEntry(&entry);
-	csv_parseEntry(&entry, "01/01/2023;31/12/2023;12345678A;Lucas;600.0;25", "TENANT");
+	csv_parseEntry(&entry, "01/01/2023;31/12/2023;12345678Z;Lucas;600.0;25", "TENANT");
 	
     error = api_addTenant(&data, entry);
     if (error != E_INVALID_ENTRY_FORMAT) {
@@ -126,7 +126,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     failed = true;
   } else {
     csv_initEntry(&entry);
-	csv_parseEntry(&entry, "01/01/2023;31/12/2023;12345678A;Lucas;600.0;25;ABC1234", "TENANT");
+	csv_parseEntry(&entry, "01/01/2023;31/12/2023;12345678Z;Lucas;600.0;25;ABC1234", "TENANT");
     
     error = api_addTenant(&data, entry);
     if (error != E_SUCCESS) {
@@ -147,7 +147,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     failed = true;
   } else {
     csv_initEntry(&entry);
-	csv_parseEntry(&entry, "01/01/2023;31/12/2023;12345678A;Lucas;600.0;25;ABC1234", "TENANT");
+	csv_parseEntry(&entry, "01/01/2023;31/12/2023;12345678Z;Lucas;600.0;25;ABC1234", "TENANT");
               
     error = api_addTenant(&data, entry);
     if (error != E_TENANT_DUPLICATED) {
@@ -168,7 +168,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     failed = true;
   } else {
     csv_initEntry(&entry);
-    csv_parseEntry(&entry, "John;87654321K;0;EXTRA", "LANDLORDD");
+    csv_parseEntry(&entry, "John;87654321X;0;EXTRA", "LANDLORDD");
 	
     error = api_addLandlord(&data, entry);
     if (error != E_INVALID_ENTRY_TYPE) {
@@ -179,7 +179,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     csv_freeEntry(&entry);
 	
 	csv_initEntry(&entry);
-	csv_parseEntry(&entry, "John;87654321K;0;EXTRA", "LANDLORD");
+	csv_parseEntry(&entry, "John;87654321X;0;EXTRA", "LANDLORD");
 	
     error = api_addLandlord(&data, entry);
     if (error != E_INVALID_ENTRY_FORMAT) {
@@ -190,7 +190,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     csv_freeEntry(&entry);
 	
 	csv_initEntry(&entry);
-	csv_parseEntry(&entry, "John;87654321K", "LANDLORD");
+	csv_parseEntry(&entry, "John;87654321X", "LANDLORD");
 	
     error = api_addLandlord(&data, entry);
     if (error != E_INVALID_ENTRY_FORMAT) {
@@ -211,7 +211,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     failed = true;
   } else {
     csv_initEntry(&entry);
-	csv_parseEntry(&entry, "John;87654321K;0", "LANDLORD");
+	csv_parseEntry(&entry, "John;87654321X;0", "LANDLORD");
               
     error = api_addLandlord(&data, entry);
     if (error != E_SUCCESS) {
@@ -232,7 +232,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     failed = true;
   } else {
     csv_initEntry(&entry);
-	csv_parseEntry(&entry, "John;87654321K;0", "LANDLORD");
+	csv_parseEntry(&entry, "John;87654321X;0", "LANDLORD");
               
     error = api_addLandlord(&data, entry);
     if (error != E_LANDLORD_DUPLICATED) {
@@ -253,7 +253,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     failed = true;
   } else {
     csv_initEntry(&entry);
-    csv_parseEntry(&entry, "ABC1234;Balmes;25;87654321K;EXTRA", "PROPERTYY");
+    csv_parseEntry(&entry, "ABC1234;Balmes;25;87654321X;EXTRA", "PROPERTYY");
 	
     error = api_addProperty(&data, entry);
     if (error != E_INVALID_ENTRY_TYPE) {
@@ -264,7 +264,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     csv_freeEntry(&entry);
 	
 	csv_initEntry(&entry);
-	csv_parseEntry(&entry, "ABC1234;Balmes;25;87654321K;EXTRA", "PROPERTY");
+	csv_parseEntry(&entry, "ABC1234;Balmes;25;87654321X;EXTRA", "PROPERTY");
 	
     error = api_addProperty(&data, entry);
     if (error != E_INVALID_ENTRY_FORMAT) {
@@ -307,7 +307,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     failed = true;
   } else {
     csv_initEntry(&entry);
-	csv_parseEntry(&entry, "ABC1234;Balmes;25;87654321K", "PROPERTY");
+	csv_parseEntry(&entry, "ABC1234;Balmes;25;87654321X", "PROPERTY");
               
     error = api_addProperty(&data, entry);
     if (error != E_SUCCESS) {
@@ -328,7 +328,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     failed = true;
   } else {
     csv_initEntry(&entry);
-	csv_parseEntry(&entry, "ABC1234;Balmes;25;87654321K", "PROPERTY");
+	csv_parseEntry(&entry, "ABC1234;Balmes;25;87654321X", "PROPERTY");
               
     error = api_addProperty(&data, entry);
     if (error != E_PROPERTY_DUPLICATED) {
@@ -349,7 +349,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     failed = true;
   } else {
     csv_initEntry(&entry);
-    csv_parseEntry(&entry, "2024;3500.0;87654321K;EXTRA", "RENTAL_INCOMEE");
+    csv_parseEntry(&entry, "2024;3500.0;87654321X;EXTRA", "RENTAL_INCOMEE");
 	
     error = api_addRentalIncome(&data, entry);
     if (error != E_INVALID_ENTRY_TYPE) {
@@ -360,7 +360,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     csv_freeEntry(&entry);
 	
 	csv_initEntry(&entry);
-	csv_parseEntry(&entry, "2024;3500.0;87654321K;EXTRA", "RENTAL_INCOME");
+	csv_parseEntry(&entry, "2024;3500.0;87654321X;EXTRA", "RENTAL_INCOME");
 	
     error = api_addRentalIncome(&data, entry);
     if (error != E_INVALID_ENTRY_FORMAT) {
@@ -403,7 +403,7 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
     failed = true;
   } else {
     csv_initEntry(&entry);
-	csv_parseEntry(&entry, "2024;3500.0;87654321K", "RENTAL_INCOME");
+	csv_parseEntry(&entry, "2024;3500.0;87654321X", "RENTAL_INCOME");
               
     error = api_addRentalIncome(&data, entry);
     if (error != E_SUCCESS) {
@@ -431,13 +431,13 @@ bool run_pr1_ex2(tTestSection *test_section, const char *input) {
         passed = false;
         fail_all = true;
     } else {
-        pRentalIncome = rentalIncomes_find(data.rentalIncomes, 2024, "87654321K");
+        pRentalIncome = rentalIncomes_find(data.rentalIncomes, 2024, "87654321X");
         
         if (pRentalIncome == NULL) {
           failed = true;
           passed = false;
           fail_all = true;
-        } else if ((strcmp(pRentalIncome->landlord->id, "87654321K") != 0)) {
+        } else if ((strcmp(pRentalIncome->landlord->id, "87654321X") != 0)) {
             failed = true;
             passed = false;
             fail_all = true;
@@ -607,8 +607,8 @@ bool run_pr1_ex3(tTestSection *test_section, const char *input) {
   } else {
     csv_initEntry(&entry);
     csv_initEntry(&refEntry);
-    csv_parseEntry(&refEntry, "John;87654321K;4800.0", "LANDLORD");
-    error = api_getLandlord(data, "87654321K", &entry);
+    csv_parseEntry(&refEntry, "John;87654321X;4800.0", "LANDLORD");
+    error = api_getLandlord(data, "87654321X", &entry);
     if (error != E_SUCCESS || !csv_equalsEntry(entry, refEntry)) {
       failed = true;
       passed = false;
@@ -646,8 +646,8 @@ bool run_pr1_ex3(tTestSection *test_section, const char *input) {
   } else {
     csv_initEntry(&entry);
     csv_initEntry(&refEntry);
-    csv_parseEntry(&refEntry, "2023;3500.0;87654321K", "RENTAL_INCOME");
-    error = api_getRentalIncome(data, 2023, "87654321K", &entry);
+    csv_parseEntry(&refEntry, "2023;3500.0;87654321X", "RENTAL_INCOME");
+    error = api_getRentalIncome(data, 2023, "87654321X", &entry);
     if (error != E_SUCCESS || !csv_equalsEntry(entry, refEntry)) {
       failed = true;
       passed = false;
@@ -674,7 +674,7 @@ bool run_pr1_ex3(tTestSection *test_section, const char *input) {
     csv_freeEntry(&entry);
 	
 	csv_initEntry(&entry);
-	error = api_getRentalIncome(data, 2026, "87654321K", &entry);
+	error = api_getRentalIncome(data, 2026, "87654321X", &entry);
 	if (error != E_RENTAL_INCOME_NOT_FOUND) {
       failed = true;
       passed = false;
@@ -694,8 +694,8 @@ bool run_pr1_ex3(tTestSection *test_section, const char *input) {
     csv_init(&report);
     csv_init(&refReport);
 
-	csv_addStrEntry(&refReport, "ABC1234;Balmes;25;87654321K", "PROPERTY");	
-	csv_addStrEntry(&refReport, "ZYX1234;Balmes;26;87654321K", "PROPERTY");
+	csv_addStrEntry(&refReport, "ABC1234;Balmes;25;87654321X", "PROPERTY");	
+	csv_addStrEntry(&refReport, "ZYX1234;Balmes;26;87654321X", "PROPERTY");
 	csv_addStrEntry(&refReport, "QWE1234;Turing;99;54927077H", "PROPERTY");
 
     error = api_getProperties(data, &report);
@@ -719,9 +719,9 @@ bool run_pr1_ex3(tTestSection *test_section, const char *input) {
     csv_init(&report);
     csv_init(&refReport);		
     		
-	csv_addStrEntry(&refReport, "2023;3500.00;87654321K" ,"RENTAL_INCOME");
+	csv_addStrEntry(&refReport, "2023;3500.00;87654321X" ,"RENTAL_INCOME");
 	csv_addStrEntry(&refReport, "2024;7500.10;54927077H" ,"RENTAL_INCOME");
-	csv_addStrEntry(&refReport, "2024;8800.55;87654321K" ,"RENTAL_INCOME");
+	csv_addStrEntry(&refReport, "2024;8800.55;87654321X" ,"RENTAL_INCOME");
 	csv_addStrEntry(&refReport, "2025;3500.99;54927077H" ,"RENTAL_INCOME");		
 		
     error = api_getRentalIncomes(data, &report);